@@ -0,0 +1,320 @@
+/*
+ * BARRIERES: Barrières de synchronisation entre threads
+ *
+ * Bibliothèque "header-only". "#pragma omp barrier" est une boîte noire;
+ * pour les solveurs itératifs à grain fin (une barrière toutes les
+ * quelques microsecondes), sa latence limite le speedup. Quatre algorithmes:
+ *
+ * 1. CENTRALISÉE À INVERSION DE SENS: un compteur partagé; le dernier
+ *    arrivé remet le compteur et inverse le "sens" sur lequel les autres
+ *    attendent. Simple, mais T threads se disputent une ligne de cache.
+ *
+ * 2. ARBRE COMBINANT: threads groupés par BARRIERE_ARITE; le dernier
+ *    arrivé d'un nœud monte au nœud parent, le dernier à la racine
+ *    inverse le sens. Au plus BARRIERE_ARITE threads par compteur.
+ *
+ *            racine
+ *           /      \
+ *       [T0..T3] [T4..T7]      (arité 4)
+ *
+ * 3. DISSÉMINATION: ceil(log2 T) tours; au tour r, le thread i prévient
+ *    le thread (i + 2^r) mod T et attend le signal de (i - 2^r) mod T.
+ *    Aucun compteur partagé, chaque drapeau a un seul écrivain.
+ *
+ *      tour 0:  0→1  1→2  2→3  3→0
+ *      tour 1:  0→2  1→3  2→0  3→1      (T = 4: 2 tours)
+ *
+ * 4. PAR SOCKET (hiérarchique): barrière centralisée dans chaque groupe
+ *    de threads d'un même socket, puis entre les chefs de groupe. Le
+ *    réveil se fait par un drapeau local au groupe: une seule ligne de
+ *    cache traverse le lien entre sockets par épisode. Les groupes sont
+ *    des numéros de thread contigus de la taille d'un socket (cf.
+ *    barriere_taille_socket): correct avec OMP_PROC_BIND=close.
+ *
+ * Toutes les barrières attendent activement puis cèdent le cœur après
+ * BARRIERE_ATTENTE_MAX tours (machines surchargées). Les écritures faites
+ * avant la barrière sont visibles après (release/acquire).
+ *
+ * Utilisation:
+ *
+ *   Barriere b;
+ *   barriere_init(&b, BARRIERE_DISSEMINATION, nb_threads);
+ *   #pragma omp parallel num_threads(nb_threads)
+ *   for (int it = 0; it < iterations; it++) {
+ *       ... calcul ...
+ *       barriere_attendre(&b, omp_get_thread_num());
+ *   }
+ *   barriere_liberer(&b);
+ *
+ * L'équipe doit compter exactement nb_threads threads: avec moins de
+ * threads (OMP_THREAD_LIMIT, OMP_DYNAMIC, imbrication) la barrière ne
+ * s'ouvrirait jamais. barriere_attendre le vérifie et arrête le programme.
+ */
+
+#ifndef BARRIERES_H
+#define BARRIERES_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdatomic.h>
+#include <sched.h>
+#include <omp.h>
+
+#define BARRIERE_LIGNE_CACHE 64
+#define BARRIERE_ARITE 4
+#define BARRIERE_ATTENTE_MAX 1024
+
+typedef enum {
+    BARRIERE_CENTRALE = 0,
+    BARRIERE_ARBRE,
+    BARRIERE_DISSEMINATION,
+    BARRIERE_SOCKET,
+    BARRIERE_NB_TYPES
+} TypeBarriere;
+
+static const char *const barriere_noms[BARRIERE_NB_TYPES] = {
+    "centrale", "arbre", "dissémination", "par socket"
+};
+
+// Chaque variable attendue est seule sur sa ligne de cache
+typedef struct {
+    _Alignas(BARRIERE_LIGNE_CACHE) atomic_int v;
+} BarriereDrapeau;
+
+typedef struct {
+    _Alignas(BARRIERE_LIGNE_CACHE) atomic_long v;
+} BarriereEpisode;
+
+typedef struct {
+    _Alignas(BARRIERE_LIGNE_CACHE) atomic_int compteur;
+    int nb;          // Arrivées attendues
+    int parent;      // -1 à la racine
+} BarriereNoeud;
+
+// État privé d'un thread (seul son propriétaire y accède)
+typedef struct {
+    _Alignas(BARRIERE_LIGNE_CACHE) int sens;
+    long episode;
+} BarriereLocal;
+
+typedef struct {
+    TypeBarriere type;
+    int nb_threads;
+    BarriereLocal *locaux;
+
+    // CENTRALE (et niveau global de SOCKET)
+    BarriereDrapeau compteur;
+    BarriereDrapeau sens;
+
+    // ARBRE: feuilles d'abord (feuille du thread i = i / BARRIERE_ARITE);
+    // SOCKET: un nœud par groupe
+    BarriereNoeud *noeuds;
+
+    // DISSÉMINATION: recu[i * nb_tours + r] = dernier épisode signalé à i au tour r
+    int nb_tours;
+    BarriereEpisode *recu;
+
+    // SOCKET
+    int taille_groupe;
+    int nb_groupes;
+    BarriereDrapeau *sens_groupes;
+} Barriere;
+
+static inline void barriere_attendre_egal(atomic_int *x, int valeur) {
+    int attente = 0;
+    while (atomic_load_explicit(x, memory_order_acquire) != valeur) {
+        if (++attente == BARRIERE_ATTENTE_MAX) {
+            sched_yield();
+            attente = 0;
+        }
+    }
+}
+
+static inline void barriere_attendre_episode(atomic_long *x, long episode) {
+    int attente = 0;
+    while (atomic_load_explicit(x, memory_order_acquire) < episode) {
+        if (++attente == BARRIERE_ATTENTE_MAX) {
+            sched_yield();
+            attente = 0;
+        }
+    }
+}
+
+// Nombre de CPU logiques du socket du CPU 0 (sysfs); 0 si inconnu
+static inline int barriere_taille_socket(void) {
+    int socket0 = -1, taille = 0;
+    for (int cpu = 0; ; cpu++) {
+        char chemin[128];
+        snprintf(chemin, sizeof(chemin),
+                 "/sys/devices/system/cpu/cpu%d/topology/physical_package_id", cpu);
+        FILE *fp = fopen(chemin, "r");
+        if (fp == NULL) break;
+        int id;
+        if (fscanf(fp, "%d", &id) == 1) {
+            if (socket0 < 0) socket0 = id;
+            if (id == socket0) taille++;
+        }
+        fclose(fp);
+    }
+    return taille;
+}
+
+static inline void *barriere_allouer(long nb, size_t taille) {
+    return aligned_alloc(BARRIERE_LIGNE_CACHE, nb * taille);
+}
+
+static inline void barriere_init(Barriere *b, TypeBarriere type, int nb_threads) {
+    b->type = type;
+    b->nb_threads = nb_threads;
+    b->locaux = (BarriereLocal*)barriere_allouer(nb_threads, sizeof(BarriereLocal));
+    for (int i = 0; i < nb_threads; i++) {
+        b->locaux[i].sens = 0;
+        b->locaux[i].episode = 0;
+    }
+    atomic_init(&b->compteur.v, nb_threads);
+    atomic_init(&b->sens.v, 0);
+    b->noeuds = NULL;
+    b->recu = NULL;
+    b->sens_groupes = NULL;
+    b->nb_tours = 0;
+    b->taille_groupe = nb_threads;
+    b->nb_groupes = 1;
+
+    if (type == BARRIERE_ARBRE) {
+        // Nombre total de nœuds: ceil(T/A) + ceil(ceil(T/A)/A) + ... + 1
+        int total = 0;
+        int niveau = nb_threads;
+        do {
+            niveau = (niveau + BARRIERE_ARITE - 1) / BARRIERE_ARITE;
+            total += niveau;
+        } while (niveau > 1);
+        b->noeuds = (BarriereNoeud*)barriere_allouer(total, sizeof(BarriereNoeud));
+
+        // Un niveau à la fois: nb_fils enfants -> nb_niveau nœuds
+        int debut = 0, nb_fils = nb_threads;
+        int nb_niveau = (nb_fils + BARRIERE_ARITE - 1) / BARRIERE_ARITE;
+        for (;;) {
+            for (int j = 0; j < nb_niveau; j++) {
+                BarriereNoeud *n = &b->noeuds[debut + j];
+                n->nb = (nb_fils - j * BARRIERE_ARITE < BARRIERE_ARITE)
+                        ? nb_fils - j * BARRIERE_ARITE : BARRIERE_ARITE;
+                atomic_init(&n->compteur, n->nb);
+                n->parent = (nb_niveau == 1) ? -1
+                            : debut + nb_niveau + j / BARRIERE_ARITE;
+            }
+            if (nb_niveau == 1) break;
+            debut += nb_niveau;
+            nb_fils = nb_niveau;
+            nb_niveau = (nb_fils + BARRIERE_ARITE - 1) / BARRIERE_ARITE;
+        }
+    } else if (type == BARRIERE_DISSEMINATION) {
+        while ((1 << b->nb_tours) < nb_threads) b->nb_tours++;
+        long nb = (long)nb_threads * (b->nb_tours > 0 ? b->nb_tours : 1);
+        b->recu = (BarriereEpisode*)barriere_allouer(nb, sizeof(BarriereEpisode));
+        for (long k = 0; k < nb; k++) atomic_init(&b->recu[k].v, 0);
+    } else if (type == BARRIERE_SOCKET) {
+        int taille = barriere_taille_socket();
+        b->taille_groupe = (taille > 0 && taille < nb_threads) ? taille : nb_threads;
+        b->nb_groupes = (nb_threads + b->taille_groupe - 1) / b->taille_groupe;
+        b->noeuds = (BarriereNoeud*)barriere_allouer(b->nb_groupes, sizeof(BarriereNoeud));
+        b->sens_groupes = (BarriereDrapeau*)barriere_allouer(b->nb_groupes, sizeof(BarriereDrapeau));
+        for (int g = 0; g < b->nb_groupes; g++) {
+            int reste = nb_threads - g * b->taille_groupe;
+            b->noeuds[g].nb = (reste < b->taille_groupe) ? reste : b->taille_groupe;
+            b->noeuds[g].parent = -1;
+            atomic_init(&b->noeuds[g].compteur, b->noeuds[g].nb);
+            atomic_init(&b->sens_groupes[g].v, 0);
+        }
+        atomic_init(&b->compteur.v, b->nb_groupes);
+    }
+}
+
+static inline void barriere_liberer(Barriere *b) {
+    free(b->locaux);
+    free(b->noeuds);
+    free(b->recu);
+    free(b->sens_groupes);
+    b->locaux = NULL;
+    b->noeuds = NULL;
+    b->recu = NULL;
+    b->sens_groupes = NULL;
+}
+
+// ============================================================================
+// ALGORITHMES
+// ============================================================================
+
+static inline void barriere_centrale(Barriere *b, int sens) {
+    if (atomic_fetch_sub_explicit(&b->compteur.v, 1, memory_order_acq_rel) == 1) {
+        // Dernier arrivé: personne ne touche le compteur avant le réveil
+        atomic_store_explicit(&b->compteur.v, b->nb_threads, memory_order_relaxed);
+        atomic_store_explicit(&b->sens.v, sens, memory_order_release);
+    } else {
+        barriere_attendre_egal(&b->sens.v, sens);
+    }
+}
+
+static inline void barriere_arbre(Barriere *b, int id, int sens) {
+    int k = id / BARRIERE_ARITE;
+    for (;;) {
+        BarriereNoeud *n = &b->noeuds[k];
+        if (atomic_fetch_sub_explicit(&n->compteur, 1, memory_order_acq_rel) != 1) {
+            break;   // Pas le dernier de ce nœud: attendre le réveil
+        }
+        atomic_store_explicit(&n->compteur, n->nb, memory_order_relaxed);
+        if (n->parent < 0) {
+            atomic_store_explicit(&b->sens.v, sens, memory_order_release);
+            return;
+        }
+        k = n->parent;
+    }
+    barriere_attendre_egal(&b->sens.v, sens);
+}
+
+static inline void barriere_dissemination(Barriere *b, int id, long episode) {
+    int t = b->nb_threads;
+    for (int r = 0; r < b->nb_tours; r++) {
+        int partenaire = (id + (1 << r)) % t;
+        atomic_store_explicit(&b->recu[(long)partenaire * b->nb_tours + r].v, episode,
+                              memory_order_release);
+        barriere_attendre_episode(&b->recu[(long)id * b->nb_tours + r].v, episode);
+    }
+}
+
+static inline void barriere_socket(Barriere *b, int id, int sens) {
+    int g = id / b->taille_groupe;
+    BarriereNoeud *groupe = &b->noeuds[g];
+    if (atomic_fetch_sub_explicit(&groupe->compteur, 1, memory_order_acq_rel) == 1) {
+        // Chef du groupe: barrière entre les groupes
+        atomic_store_explicit(&groupe->compteur, groupe->nb, memory_order_relaxed);
+        if (atomic_fetch_sub_explicit(&b->compteur.v, 1, memory_order_acq_rel) == 1) {
+            atomic_store_explicit(&b->compteur.v, b->nb_groupes, memory_order_relaxed);
+            atomic_store_explicit(&b->sens.v, sens, memory_order_release);
+        } else {
+            barriere_attendre_egal(&b->sens.v, sens);
+        }
+        atomic_store_explicit(&b->sens_groupes[g].v, sens, memory_order_release);
+    } else {
+        barriere_attendre_egal(&b->sens_groupes[g].v, sens);
+    }
+}
+
+// Appelée par chacun des nb_threads threads, id = omp_get_thread_num()
+static inline void barriere_attendre(Barriere *b, int id) {
+    if (omp_get_num_threads() != b->nb_threads) {
+        fprintf(stderr, "Erreur: barrière pour %d threads, équipe de %d threads\n",
+                b->nb_threads, omp_get_num_threads());
+        abort();
+    }
+    BarriereLocal *l = &b->locaux[id];
+    l->sens = !l->sens;
+    l->episode++;
+    switch (b->type) {
+    case BARRIERE_CENTRALE:      barriere_centrale(b, l->sens); break;
+    case BARRIERE_ARBRE:         barriere_arbre(b, id, l->sens); break;
+    case BARRIERE_DISSEMINATION: barriere_dissemination(b, id, l->episode); break;
+    default:                     barriere_socket(b, id, l->sens); break;
+    }
+}
+
+#endif
@@ -0,0 +1,247 @@
+/*
+ * BENCHMARK: Opérations atomiques C11 (stdatomic.h) et ordres mémoire
+ *
+ * lab2 et le quiz n'utilisent que "#pragma omp atomic" (seq_cst). Ici on
+ * mesure les primitives de <stdatomic.h> directement:
+ *
+ *   Opérations : fetch_add, boucle CAS (compare_exchange_weak), exchange
+ *   Ordres     : relaxed, acq_rel, seq_cst
+ *   Contention : partagée     (1 variable, 1 ligne de cache pour tous)
+ *                faux partage (1 variable par thread, toutes sur 1 ligne)
+ *                séparée      (1 variable par thread, 1 ligne chacune)
+ *
+ * Pour chaque combinaison et chaque nombre de threads:
+ *   - ns/op  : temps vu par un thread pour une opération
+ *   - Mops/s : débit total (courbe d'effondrement sous contention)
+ *   - échecs CAS par opération (boucle CAS seulement)
+ *
+ * Usage: ./bench_atomiques [ops_par_thread] [--csv [fichier]]
+ *        (défaut: 2e6 ops, CSV: atomiques.csv)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <omp.h>
+
+#define LIGNE_CACHE 64
+#define MAX_THREADS 256
+// Nombre de atomic_long par ligne de cache
+#define PAR_LIGNE ((long)(LIGNE_CACHE / sizeof(atomic_long)))
+
+#define NB_OPS 3
+#define NB_ORDRES 3
+#define NB_CONTENTIONS 3
+
+static const char *noms_ops[NB_OPS] = {"fetch_add", "CAS", "exchange"};
+static const char *noms_ordres[NB_ORDRES] = {"relaxed", "acq_rel", "seq_cst"};
+static const char *noms_contentions[NB_CONTENTIONS] = {"partagée", "faux partage", "séparée"};
+
+// Une boucle de n opérations; retourne le nombre d'échecs CAS
+typedef long (*Boucle)(atomic_long *v, long n);
+
+// L'ordre mémoire doit être une constante pour que le compilateur génère
+// le code correspondant: une fonction par (opération, ordre)
+#define DEFINIR_BOUCLES(suffixe, ordre, ordre_echec)                            \
+static long boucle_fetch_add_##suffixe(atomic_long *v, long n) {                \
+    for (long i = 0; i < n; i++) {                                              \
+        atomic_fetch_add_explicit(v, 1, ordre);                                 \
+    }                                                                           \
+    return 0;                                                                   \
+}                                                                               \
+                                                                                \
+static long boucle_cas_##suffixe(atomic_long *v, long n) {                      \
+    long echecs = 0;                                                            \
+    for (long i = 0; i < n; i++) {                                              \
+        long attendu = atomic_load_explicit(v, memory_order_relaxed);           \
+        while (!atomic_compare_exchange_weak_explicit(v, &attendu, attendu + 1, \
+                                                      ordre, ordre_echec)) {    \
+            echecs++;                                                           \
+        }                                                                       \
+    }                                                                           \
+    return echecs;                                                              \
+}                                                                               \
+                                                                                \
+static long boucle_exchange_##suffixe(atomic_long *v, long n) {                 \
+    for (long i = 0; i < n; i++) {                                              \
+        atomic_exchange_explicit(v, i, ordre);                                  \
+    }                                                                           \
+    return 0;                                                                   \
+}
+
+// L'ordre d'échec d'un CAS ne peut pas être release ni acq_rel
+DEFINIR_BOUCLES(relaxed, memory_order_relaxed, memory_order_relaxed)
+DEFINIR_BOUCLES(acq_rel, memory_order_acq_rel, memory_order_acquire)
+DEFINIR_BOUCLES(seq_cst, memory_order_seq_cst, memory_order_seq_cst)
+
+static Boucle boucles[NB_OPS][NB_ORDRES] = {
+    {boucle_fetch_add_relaxed, boucle_fetch_add_acq_rel, boucle_fetch_add_seq_cst},
+    {boucle_cas_relaxed,       boucle_cas_acq_rel,       boucle_cas_seq_cst},
+    {boucle_exchange_relaxed,  boucle_exchange_acq_rel,  boucle_exchange_seq_cst},
+};
+
+typedef struct {
+    double ns_par_op;     // Temps par opération vu par un thread
+    double mops;          // Débit total, millions d'opérations/s
+    double echecs;        // Échecs CAS par opération réussie
+    int correct;
+} Mesure;
+
+// Indice de la variable du thread id selon la contention
+static long indice_variable(int contention, int id) {
+    switch (contention) {
+    case 0:  return 0;                          // Partagée
+    case 1:  return id;                         // Voisines: PAR_LIGNE par ligne
+    default: return (long)id * PAR_LIGNE;       // Une ligne chacune
+    }
+}
+
+static Mesure mesurer(atomic_long *vars, int op, int ordre, int contention,
+                      int nb_threads, long n) {
+    long nb_vars = (long)MAX_THREADS * PAR_LIGNE;
+    for (long i = 0; i < nb_vars; i++) atomic_init(&vars[i], 0);
+
+    Boucle boucle = boucles[op][ordre];
+    long echecs = 0;
+    double temps_max = 0.0;
+
+    #pragma omp parallel num_threads(nb_threads) reduction(+:echecs) reduction(max:temps_max)
+    {
+        atomic_long *v = &vars[indice_variable(contention, omp_get_thread_num())];
+        #pragma omp barrier
+        double start = omp_get_wtime();
+        echecs += boucle(v, n);
+        temps_max = omp_get_wtime() - start;
+    }
+
+    // fetch_add et CAS: le total des incréments doit être exact
+    int correct = 1;
+    if (op != 2) {
+        long total = 0;
+        for (long i = 0; i < nb_vars; i++) total += atomic_load(&vars[i]);
+        correct = (total == n * nb_threads);
+    }
+
+    Mesure m;
+    m.ns_par_op = temps_max / n * 1e9;
+    m.mops = (double)n * nb_threads / temps_max * 1e-6;
+    m.echecs = (double)echecs / ((double)n * nb_threads);
+    m.correct = correct;
+    return m;
+}
+
+int main(int argc, char *argv[]) {
+    long n = 2000000L;
+    const char *fichier_csv = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--csv") == 0) {
+            fichier_csv = (i + 1 < argc && argv[i + 1][0] != '-') ? argv[++i] : "atomiques.csv";
+        } else {
+            n = (long)strtod(argv[i], NULL);
+        }
+    }
+    if (n <= 0) {
+        fprintf(stderr, "Erreur: Nombre d'opérations invalide\n");
+        return 1;
+    }
+
+    int max_threads = omp_get_max_threads() * 2;
+    if (max_threads > MAX_THREADS) max_threads = MAX_THREADS;
+    int nb_t = 0;
+    int threads[16];
+    for (int t = 1; t <= max_threads && nb_t < 16; t *= 2) threads[nb_t++] = t;
+
+    atomic_long *vars = (atomic_long*)aligned_alloc(LIGNE_CACHE,
+                            (size_t)MAX_THREADS * PAR_LIGNE * sizeof(atomic_long));
+    static Mesure res[NB_OPS][NB_ORDRES][NB_CONTENTIONS][16];
+    int erreurs = 0;
+
+    printf("================================================================================\n");
+    printf("  OPÉRATIONS ATOMIQUES C11: fetch_add, CAS, exchange × ordres mémoire\n");
+    printf("================================================================================\n");
+    printf("Opérations par thread: %ld | Cœurs: %d\n\n", n, omp_get_num_procs());
+
+    // ------------------------------------------------------------------------
+    printf("1. LATENCE: ns par opération (vu par un thread)\n");
+    printf("   %-10s %-8s %-13s", "Opération", "Ordre", "Contention");
+    for (int k = 0; k < nb_t; k++) printf(" %7d th", threads[k]);
+    printf("\n");
+
+    for (int op = 0; op < NB_OPS; op++) {
+        for (int ordre = 0; ordre < NB_ORDRES; ordre++) {
+            for (int c = 0; c < NB_CONTENTIONS; c++) {
+                printf("   %-10s %-8s %-13s", noms_ops[op], noms_ordres[ordre], noms_contentions[c]);
+                for (int k = 0; k < nb_t; k++) {
+                    Mesure m = mesurer(vars, op, ordre, c, threads[k], n);
+                    res[op][ordre][c][k] = m;
+                    if (!m.correct) erreurs++;
+                    printf(" %9.2f%s", m.ns_par_op, m.correct ? " " : "✗");
+                }
+                printf("\n");
+            }
+        }
+        printf("\n");
+    }
+
+    // ------------------------------------------------------------------------
+    printf("2. EFFONDREMENT DU DÉBIT (seq_cst): Mops/s total\n");
+    printf("   %-10s %-13s", "Opération", "Contention");
+    for (int k = 0; k < nb_t; k++) printf(" %7d th", threads[k]);
+    printf("\n");
+    for (int op = 0; op < NB_OPS; op++) {
+        for (int c = 0; c < NB_CONTENTIONS; c++) {
+            printf("   %-10s %-13s", noms_ops[op], noms_contentions[c]);
+            for (int k = 0; k < nb_t; k++) printf(" %10.1f", res[op][2][c][k].mops);
+            printf("\n");
+        }
+    }
+    printf("\n");
+
+    // ------------------------------------------------------------------------
+    printf("3. ÉCHECS CAS par opération (variable partagée)\n");
+    printf("   %-8s", "Ordre");
+    for (int k = 0; k < nb_t; k++) printf(" %7d th", threads[k]);
+    printf("\n");
+    for (int ordre = 0; ordre < NB_ORDRES; ordre++) {
+        printf("   %-8s", noms_ordres[ordre]);
+        for (int k = 0; k < nb_t; k++) printf(" %10.3f", res[1][ordre][0][k].echecs);
+        printf("\n");
+    }
+
+    if (fichier_csv != NULL) {
+        FILE *fp = fopen(fichier_csv, "w");
+        if (fp == NULL) {
+            fprintf(stderr, "Erreur: Impossible de créer le fichier CSV %s\n", fichier_csv);
+            free(vars);
+            return 1;
+        }
+        fprintf(fp, "operation,ordre,contention,threads,ns_par_op,mops,echecs_cas\n");
+        for (int op = 0; op < NB_OPS; op++)
+            for (int ordre = 0; ordre < NB_ORDRES; ordre++)
+                for (int c = 0; c < NB_CONTENTIONS; c++)
+                    for (int k = 0; k < nb_t; k++) {
+                        Mesure *m = &res[op][ordre][c][k];
+                        fprintf(fp, "%s,%s,%s,%d,%.3f,%.3f,%.4f\n", noms_ops[op],
+                                noms_ordres[ordre], noms_contentions[c], threads[k],
+                                m->ns_par_op, m->mops, m->echecs);
+                    }
+        fclose(fp);
+        printf("\nFichier CSV généré: %s\n", fichier_csv);
+    }
+    free(vars);
+
+    printf("\n================================================================================\n");
+    printf("ANALYSE\n");
+    printf("================================================================================\n");
+    printf("- x86: toute opération read-modify-write est un \"lock\" (barrière complète),\n");
+    printf("  relaxed/acq_rel/seq_cst coûtent pareil; l'écart apparaît sur ARM/POWER\n");
+    printf("- Partagée et faux partage: la ligne fait la navette entre les cœurs, le\n");
+    printf("  débit total baisse quand on ajoute des threads\n");
+    printf("- Séparée: chaque cœur garde sa ligne, le débit croît avec les threads\n");
+    printf("- CAS: sous contention, les échecs s'ajoutent (boucle de réessai);\n");
+    printf("  préférer fetch_add quand l'opération existe\n");
+
+    return erreurs != 0;
+}
@@ -0,0 +1,197 @@
+/*
+ * BENCHMARK: Barrières (barrieres.h) vs #pragma omp barrier
+ *
+ * 1. Validation: aucun thread ne franchit l'épisode e avant que tous
+ *    soient arrivés, ni n'a deux épisodes d'avance
+ * 2. Latence: ns par barrière, de 2 threads à tous les cœurs
+ * 3. Noyau itératif: Jacobi 1D à grain fin (une barrière par itération),
+ *    même résultat exigé avec chaque barrière
+ *
+ * Usage: ./bench_barrieres [nb_barrieres]     (défaut: 1e5)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <omp.h>
+#include "barrieres.h"
+
+#define NB_METHODES (BARRIERE_NB_TYPES + 1)      // + omp barrier
+#define OMP_BARRIER BARRIERE_NB_TYPES
+#define JACOBI_N 16384                           // 128 Ko par tableau: en cache
+
+static const char *nom_methode(int m) {
+    return (m == OMP_BARRIER) ? "omp barrier" : barriere_noms[m];
+}
+
+// Une barrière de la méthode m (b non utilisée pour omp barrier)
+#define BARRIERE(m, b, id) do {                                                 \
+    if ((m) == OMP_BARRIER) {                                                   \
+        _Pragma("omp barrier")                                                  \
+    } else {                                                                    \
+        barriere_attendre((b), (id));                                           \
+    }                                                                           \
+} while (0)
+
+// Retourne le nombre de violations
+static long valider(int m, int nb_threads, long episodes) {
+    Barriere b;
+    if (m != OMP_BARRIER) barriere_init(&b, (TypeBarriere)m, nb_threads);
+    BarriereEpisode *phase = (BarriereEpisode*)barriere_allouer(nb_threads, sizeof(BarriereEpisode));
+    for (int i = 0; i < nb_threads; i++) atomic_init(&phase[i].v, 0);
+    long violations = 0;
+
+    #pragma omp parallel num_threads(nb_threads) reduction(+:violations)
+    {
+        int id = omp_get_thread_num();
+        for (long e = 1; e <= episodes; e++) {
+            atomic_store(&phase[id].v, e);
+            BARRIERE(m, &b, id);
+            for (int j = 0; j < nb_threads; j++) {
+                long p = atomic_load(&phase[j].v);
+                if (p < e || p > e + 1) violations++;
+            }
+        }
+    }
+
+    free(phase);
+    if (m != OMP_BARRIER) barriere_liberer(&b);
+    return violations;
+}
+
+static double latence(int m, int nb_threads, long episodes) {
+    Barriere b;
+    if (m != OMP_BARRIER) barriere_init(&b, (TypeBarriere)m, nb_threads);
+    double temps = 0.0;
+
+    #pragma omp parallel num_threads(nb_threads)
+    {
+        int id = omp_get_thread_num();
+        for (long e = 0; e < episodes / 10; e++) BARRIERE(m, &b, id);   // Échauffement
+        #pragma omp barrier
+        double start = omp_get_wtime();
+        for (long e = 0; e < episodes; e++) BARRIERE(m, &b, id);
+        if (id == 0) temps = omp_get_wtime() - start;
+    }
+
+    if (m != OMP_BARRIER) barriere_liberer(&b);
+    return temps / episodes * 1e9;
+}
+
+// Jacobi 1D: x'[i] = (x[i-1] + x[i] + x[i+1]) / 3, bords fixes
+static double jacobi(int m, int nb_threads, long iterations, double *resultat) {
+    double *x = (double*)malloc(JACOBI_N * sizeof(double));
+    double *y = (double*)malloc(JACOBI_N * sizeof(double));
+    for (int i = 0; i < JACOBI_N; i++) x[i] = y[i] = (i == 0) ? 1.0 : 0.0;
+    Barriere b;
+    if (m != OMP_BARRIER) barriere_init(&b, (TypeBarriere)m, nb_threads);
+
+    double start = omp_get_wtime();
+    #pragma omp parallel num_threads(nb_threads)
+    {
+        int id = omp_get_thread_num();
+        int nb = omp_get_num_threads();
+        int debut = 1 + (JACOBI_N - 2) * id / nb;
+        int fin = 1 + (JACOBI_N - 2) * (id + 1) / nb;
+        double *ancien = x, *nouveau = y;
+        for (long it = 0; it < iterations; it++) {
+            for (int i = debut; i < fin; i++) {
+                nouveau[i] = (ancien[i - 1] + ancien[i] + ancien[i + 1]) * (1.0 / 3.0);
+            }
+            BARRIERE(m, &b, id);
+            double *tmp = ancien; ancien = nouveau; nouveau = tmp;
+        }
+    }
+    double temps = omp_get_wtime() - start;
+
+    double *final = (iterations % 2 == 0) ? x : y;
+    double s = 0.0;
+    for (int i = 0; i < JACOBI_N; i++) s += final[i] * (i + 1);
+    *resultat = s;
+    free(x);
+    free(y);
+    if (m != OMP_BARRIER) barriere_liberer(&b);
+    return temps;
+}
+
+int main(int argc, char *argv[]) {
+    long episodes = (argc > 1) ? (long)strtod(argv[1], NULL) : 100000L;
+    int max_threads = omp_get_max_threads();
+    if (max_threads < 2) max_threads = 2;
+    int erreurs = 0;
+
+    // Équipe réellement obtenue (OMP_THREAD_LIMIT, OMP_DYNAMIC): les
+    // barrières sont dimensionnées pour nb_threads threads exactement
+    int equipe = 0;
+    #pragma omp parallel num_threads(max_threads)
+    #pragma omp single
+    equipe = omp_get_num_threads();
+    if (equipe < 2) {
+        fprintf(stderr, "Erreur: Équipe de %d thread, il en faut au moins 2\n", equipe);
+        return 1;
+    }
+    max_threads = equipe;
+
+    // 2, 4, 8, ... puis tous les threads
+    int threads[32], nb_t = 0;
+    for (int t = 2; t < max_threads && nb_t < 31; t *= 2) threads[nb_t++] = t;
+    threads[nb_t++] = max_threads;
+
+    int taille_socket = barriere_taille_socket();
+    printf("================================================================================\n");
+    printf("  BARRIÈRES: centrale, arbre, dissémination, par socket vs omp barrier\n");
+    printf("================================================================================\n");
+    printf("Cœurs: %d | Threads par socket: %d | Arité de l'arbre: %d\n\n",
+           omp_get_num_procs(), taille_socket, BARRIERE_ARITE);
+
+    // ------------------------------------------------------------------------
+    printf("1. VALIDATION (%d threads, 2000 épisodes)\n", max_threads);
+    for (int m = 0; m < NB_METHODES; m++) {
+        long v = valider(m, max_threads, 2000);
+        if (v) erreurs++;
+        printf("   %-15s %s\n", nom_methode(m), v ? "✗ thread en avance" : "✓");
+    }
+    printf("\n");
+
+    // ------------------------------------------------------------------------
+    printf("2. LATENCE: ns par barrière (%ld barrières)\n", episodes);
+    printf("   %-15s", "Barrière");
+    for (int k = 0; k < nb_t; k++) printf(" %7d th", threads[k]);
+    printf("\n");
+    for (int m = 0; m < NB_METHODES; m++) {
+        printf("   %-15s", nom_methode(m));
+        for (int k = 0; k < nb_t; k++) printf(" %10.0f", latence(m, threads[k], episodes));
+        printf("\n");
+    }
+    printf("\n");
+
+    // ------------------------------------------------------------------------
+    long iterations = episodes / 10;
+    printf("3. NOYAU: Jacobi 1D, %d points, %ld itérations, %d threads\n",
+           JACOBI_N, iterations, max_threads);
+    double ref = 0.0, temps_omp = 0.0;
+    jacobi(OMP_BARRIER, max_threads, iterations, &ref);
+    for (int m = NB_METHODES - 1; m >= 0; m--) {
+        double r;
+        double temps = jacobi(m, max_threads, iterations, &r);
+        if (m == OMP_BARRIER) temps_omp = temps;
+        int ok = (r == ref);
+        if (!ok) erreurs++;
+        printf("   %-15s %9.4f s | %7.2f µs/itération | %5.2fx vs omp %s\n",
+               nom_methode(m), temps, temps / iterations * 1e6, temps_omp / temps,
+               ok ? "✓" : "✗");
+    }
+
+    printf("\n================================================================================\n");
+    printf("ANALYSE\n");
+    printf("================================================================================\n");
+    printf("- Centrale: T écritures sur la même ligne, latence en O(T)\n");
+    printf("- Arbre: au plus %d threads par compteur, latence en O(log T)\n", BARRIERE_ARITE);
+    printf("- Dissémination: log2(T) tours, chaque drapeau n'a qu'un écrivain:\n");
+    printf("  aucun point chaud, mais T log2(T) signaux par épisode\n");
+    printf("- Par socket: une seule ligne traverse le lien entre sockets\n");
+    printf("- Plus de threads que de cœurs: toute barrière active doit céder le cœur\n");
+    printf("  (sched_yield), la latence devient celle de l'ordonnanceur du système\n");
+
+    return erreurs != 0;
+}
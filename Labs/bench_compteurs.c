@@ -0,0 +1,146 @@
+/*
+ * BENCHMARK: Compteurs partagés (compteurs.h)
+ *
+ * Chaque thread fait INCREMENTS_PAR_THREAD incréments; on compare:
+ * 1. Tableau long[nb_threads] non aligné, indexé par thread (comme compteur[8]
+ *    dans collapse_demo.c): correct mais faux partage
+ * 2. Compteur réparti: une case par ligne de cache
+ * 3. Compteur approximatif: publication atomique tous les SEUIL incréments
+ * 4. #pragma omp atomic sur une seule variable
+ * 5. #pragma omp critical
+ *
+ * Mesure: millions d'incréments par seconde, de 1 thread à tous les cœurs.
+ *
+ * Usage: ./bench_compteurs [increments_par_thread]   (défaut: 1e7)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <omp.h>
+#include "compteurs.h"
+
+#define SEUIL_APPROX 1024
+#define NB_METHODES 5
+
+static const char *noms[NB_METHODES] = {
+    "tableau non aligné", "réparti (aligné)", "approximatif", "omp atomic", "omp critical"
+};
+
+// Retourne le total lu après la région parallèle
+static long executer(int methode, int nb_threads, long increments) {
+    long total = 0;
+
+    switch (methode) {
+    case 0: {
+        // volatile: un incrément = une lecture + une écriture en mémoire,
+        // comme lorsque la boucle fait autre chose entre deux incréments
+        // Une case par thread, contiguës (pas d'alignement par case)
+        volatile long *compteur = (volatile long*)calloc(nb_threads, sizeof(long));
+        #pragma omp parallel num_threads(nb_threads)
+        {
+            int id = omp_get_thread_num();
+            for (long i = 0; i < increments; i++) {
+                compteur[id]++;
+            }
+        }
+        for (int t = 0; t < nb_threads; t++) total += compteur[t];
+        free((void*)compteur);
+        break;
+    }
+    case 1: {
+        CompteurReparti c;
+        compteur_reparti_init(&c, nb_threads);
+        #pragma omp parallel num_threads(nb_threads)
+        {
+            int id = omp_get_thread_num();
+            for (long i = 0; i < increments; i++) {
+                compteur_reparti_ajouter(&c, id, 1);
+            }
+        }
+        total = compteur_reparti_lire(&c);
+        compteur_reparti_liberer(&c);
+        break;
+    }
+    case 2: {
+        CompteurApprox c;
+        compteur_approx_init(&c, SEUIL_APPROX);
+        #pragma omp parallel num_threads(nb_threads)
+        {
+            CompteurApproxLocal local = {0};
+            for (long i = 0; i < increments; i++) {
+                compteur_approx_ajouter(&c, &local, 1);
+            }
+            compteur_approx_vider(&c, &local);
+        }
+        total = compteur_approx_lire(&c);
+        break;
+    }
+    case 3: {
+        long compteur = 0;
+        #pragma omp parallel num_threads(nb_threads)
+        {
+            for (long i = 0; i < increments; i++) {
+                #pragma omp atomic
+                compteur++;
+            }
+        }
+        total = compteur;
+        break;
+    }
+    default: {
+        long compteur = 0;
+        #pragma omp parallel num_threads(nb_threads)
+        {
+            for (long i = 0; i < increments; i++) {
+                #pragma omp critical
+                compteur++;
+            }
+        }
+        total = compteur;
+        break;
+    }
+    }
+    return total;
+}
+
+int main(int argc, char *argv[]) {
+    long increments = (argc > 1) ? (long)strtod(argv[1], NULL) : 10000000L;
+    int max_threads = omp_get_max_threads();
+    int erreurs = 0;
+
+    printf("================================================================================\n");
+    printf("  COMPTEURS PARTAGÉS: faux partage, atomic, critical, compteurs répartis\n");
+    printf("================================================================================\n");
+    printf("Incréments par thread: %ld | Seuil approximatif: %d\n\n", increments, SEUIL_APPROX);
+
+    printf("%-22s", "M incréments/s");
+    for (int t = 1; t <= max_threads * 2; t *= 2) printf(" %8d th", t);
+    printf("\n");
+
+    for (int m = 0; m < NB_METHODES; m++) {
+        // critical est ~100x plus lent: moins d'incréments pour rester court
+        long n = (m == 4) ? increments / 10 : increments;
+        printf("%-22s", noms[m]);
+        for (int t = 1; t <= max_threads * 2; t *= 2) {
+            double start = omp_get_wtime();
+            long total = executer(m, t, n);
+            double temps = omp_get_wtime() - start;
+            int ok = (total == n * t);
+            if (!ok) erreurs++;
+            printf(" %10.1f%s", (double)n * t / temps * 1e-6, ok ? " " : "✗");
+        }
+        printf("\n");
+    }
+
+    printf("\n================================================================================\n");
+    printf("ANALYSE\n");
+    printf("================================================================================\n");
+    printf("- Tableau non aligné: correct, mais toutes les cases partagent une ligne de\n");
+    printf("  cache qui fait la navette entre les cœurs (faux partage)\n");
+    printf("- Réparti: une ligne par thread, aucun échange tant qu'on ne lit pas\n");
+    printf("- Approximatif: 1 atomic pour %d incréments, lecture possible à tout moment\n",
+           SEUIL_APPROX);
+    printf("- atomic/critical: une seule ligne disputée par tous les threads\n");
+
+    return erreurs != 0;
+}
@@ -0,0 +1,134 @@
+/*
+ * BENCHMARK: Réductions fusionnées avec la génération (generateur.h)
+ *
+ * 1. Matérialisé (remplir le tableau puis le sommer, comme init_array +
+ *    sum_with_reduction dans lab2) vs fusionné (somme directe du générateur)
+ *    pour chaque générateur, même résultat exigé
+ * 2. Mémoire constante: somme fusionnée de très grandes tailles (1e10,
+ *    1e11...) impossibles à matérialiser, vérifiée par formule
+ *
+ * Usage: ./bench_generateur [n_materialise] [n_fusionne]   (défaut: 1e8, 1e10)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <omp.h>
+#include "generateur.h"
+
+#define GRAINE 12345
+
+// Sommes exactes modulo 2^64
+static uint64_t attendu_lineaire(long n) {
+    return (uint64_t)((unsigned __int128)n * (n + 1) / 2);
+}
+
+static uint64_t attendu_motif(long n) {
+    long r = n % 1000;
+    return (uint64_t)(n / 1000) * 500500u + (uint64_t)r * (r + 1) / 2;
+}
+
+static void afficher(const char *nom, double t_remplir, double t_sommer, double t_fusion,
+                     long n, int ok) {
+    double t_mat = t_remplir + t_sommer;
+    printf("   %-10s %9.4f + %9.4f = %9.4f s | %9.4f s %8.2f Gelem/s | %5.1fx %s\n",
+           nom, t_remplir, t_sommer, t_mat, t_fusion, n / t_fusion * 1e-9,
+           t_mat / t_fusion, ok ? "✓" : "✗");
+}
+
+// Matérialisé vs fusionné pour un générateur; retourne 1 si les résultats diffèrent
+#define COMPARER(nom, type, type_somme, egal)                                   \
+static int comparer_##nom(long n, int t) {                                      \
+    type *a = (type*)malloc(n * sizeof(type));                                  \
+    if (!a) {                                                                   \
+        printf("   %-10s ⚠️  mémoire insuffisante (%.1f Go), ignoré\n",         \
+               #nom, n * sizeof(type) / 1e9);                                   \
+        return 0;                                                               \
+    }                                                                           \
+    remplir_gen_##nom(a, 0, n, GRAINE, t);   /* Pages touchées hors mesure */   \
+    double start = omp_get_wtime();                                             \
+    remplir_gen_##nom(a, 0, n, GRAINE, t);                                      \
+    double t_remplir = omp_get_wtime() - start;                                 \
+    start = omp_get_wtime();                                                    \
+    type_somme s_mat = somme_tableau_##nom(a, n, t);                            \
+    double t_sommer = omp_get_wtime() - start;                                  \
+    start = omp_get_wtime();                                                    \
+    type_somme s_fus = somme_gen_##nom(0, n, GRAINE, t);                        \
+    double t_fusion = omp_get_wtime() - start;                                  \
+    free(a);                                                                    \
+    int ok = egal(s_mat, s_fus);                                                \
+    afficher(#nom, t_remplir, t_sommer, t_fusion, n, ok);                       \
+    return !ok;                                                                 \
+}
+
+#define EGAL_EXACT(x, y) ((x) == (y))
+#define EGAL_FLOTTANT(x, y) (fabs((x) - (y)) <= 1e-9 * fabs(x))
+
+COMPARER(lineaire, uint64_t, uint64_t, EGAL_EXACT)
+COMPARER(motif, int32_t, uint64_t, EGAL_EXACT)
+COMPARER(aleatoire, uint64_t, uint64_t, EGAL_EXACT)
+COMPARER(uniforme, double, double, EGAL_FLOTTANT)
+
+int main(int argc, char *argv[]) {
+    long n_mat = (argc > 1) ? (long)strtod(argv[1], NULL) : 100000000L;
+    long n_fus = (argc > 2) ? (long)strtod(argv[2], NULL) : 10000000000L;
+    int t = omp_get_max_threads();
+    int erreurs = 0;
+
+    printf("================================================================================\n");
+    printf("  RÉDUCTIONS FUSIONNÉES: générer et sommer sans matérialiser le tableau\n");
+    printf("================================================================================\n");
+    printf("Threads: %d\n\n", t);
+
+    // ------------------------------------------------------------------------
+    printf("1. MATÉRIALISÉ vs FUSIONNÉ: %ld éléments\n", n_mat);
+    printf("   %-10s %9s + %9s = %9s   | %9s   %15s | %6s\n", "Générateur",
+           "remplir", "sommer", "total", "fusionné", "débit", "gain");
+    erreurs += comparer_lineaire(n_mat, t);
+    erreurs += comparer_motif(n_mat, t);
+    erreurs += comparer_aleatoire(n_mat, t);
+    erreurs += comparer_uniforme(n_mat, t);
+    printf("\n");
+
+    // ------------------------------------------------------------------------
+    printf("2. MÉMOIRE CONSTANTE: %ld éléments (matérialisé: %.0f Go en uint64)\n",
+           n_fus, n_fus * 8.0 / 1e9);
+    double start = omp_get_wtime();
+    uint64_t s = somme_gen_lineaire(0, n_fus, GRAINE, t);
+    double temps = omp_get_wtime() - start;
+    int ok = (s == attendu_lineaire(n_fus));
+    if (!ok) erreurs++;
+    printf("   %-10s %9.2f s %8.2f Gelem/s | somme mod 2^64 = %llu %s\n", "lineaire",
+           temps, n_fus / temps * 1e-9, (unsigned long long)s, ok ? "✓" : "✗");
+
+    start = omp_get_wtime();
+    s = somme_gen_motif(0, n_fus, GRAINE, t);
+    temps = omp_get_wtime() - start;
+    ok = (s == attendu_motif(n_fus));
+    if (!ok) erreurs++;
+    printf("   %-10s %9.2f s %8.2f Gelem/s | somme = %llu %s\n", "motif",
+           temps, n_fus / temps * 1e-9, (unsigned long long)s, ok ? "✓" : "✗");
+
+    start = omp_get_wtime();
+    double moyenne = somme_gen_uniforme(0, n_fus, GRAINE, t) / n_fus;
+    temps = omp_get_wtime() - start;
+    // Écart type de la moyenne: 1/sqrt(12 n); on tolère 6 écarts types
+    ok = fabs(moyenne - 0.5) < 6.0 / sqrt(12.0 * n_fus);
+    if (!ok) erreurs++;
+    printf("   %-10s %9.2f s %8.2f Gelem/s | moyenne = %.9f %s\n", "uniforme",
+           temps, n_fus / temps * 1e-9, moyenne, ok ? "✓" : "✗");
+
+    printf("\n================================================================================\n");
+    printf("ANALYSE\n");
+    printf("================================================================================\n");
+    printf("- Matérialisé: 1 écriture + 1 lecture par élément, limité par la mémoire\n");
+    printf("- Fusionné: aucun trafic mémoire, limité par le coût du générateur\n");
+    printf("  (gain maximal pour les générateurs bon marché: lineaire)\n");
+    printf("- motif: un modulo 64 bits par élément coûte plus que relire 4 octets,\n");
+    printf("  la fusion ne gagne que si générer est moins cher que lire\n");
+    printf("- Générateur à compteur: chaque thread produit sa plage sans état\n");
+    printf("  partagé, le résultat entier ne dépend pas du nombre de threads\n");
+    printf("- Sommes uint64 modulo 2^64: exactes même au-delà de 1e11 éléments\n");
+
+    return erreurs != 0;
+}
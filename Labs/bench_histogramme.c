@@ -0,0 +1,151 @@
+/*
+ * BENCHMARK: Histogrammes parallèles (histogramme.h)
+ *
+ * 4 régimes: 256 ou 1M cases × entrée uniforme ou biaisée
+ *   uniforme: chaque case a la même probabilité
+ *   biaisée : case = u^8 * nb_cases (u uniforme): la moitié des valeurs
+ *             tombe dans la case 0 avec 256 cases, 18% avec 1M cases
+ *
+ * Pour chaque régime: les 4 stratégies, de 1 thread à 2x les cœurs,
+ * vérifiées contre l'histogramme séquentiel, et la gagnante. La partition
+ * reçoit un hist neuf par nombre de threads, placé par tranche.
+ *
+ * Usage: ./bench_histogramme [nb_valeurs]     (défaut: 5e7)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <omp.h>
+#include "histogramme.h"
+#include "generateur.h"
+
+#define NB_STRATEGIES 4
+
+typedef void (*Histo)(const uint32_t*, long, long*, int, int);
+
+static const char *noms[NB_STRATEGIES] = {
+    "atomiques partagées", "reduction(+:hist[:])", "privées + arbre", "privées + partition"
+};
+static Histo strategies[NB_STRATEGIES] = {
+    histo_atomique, histo_reduction, histo_arbre, histo_partitionne
+};
+
+static void generer(uint32_t *valeurs, long n, int nb_cases, int biaise) {
+    #pragma omp parallel for schedule(static)
+    for (long i = 0; i < n; i++) {
+        double u = gen_uniforme(i, 2024);
+        if (biaise) u = pow(u, 8.0);
+        valeurs[i] = (uint32_t)(u * nb_cases);
+    }
+}
+
+// Retourne le nombre d'erreurs
+static int regime(const uint32_t *valeurs, long n, int nb_cases, const char *nom_entree,
+                  int max_threads) {
+    long *ref = (long*)malloc(nb_cases * sizeof(long));
+    long *hist = (long*)malloc(nb_cases * sizeof(long));
+    histo_sequentiel(valeurs, n, ref, nb_cases);
+
+    long max_case = 0;
+    for (int c = 0; c < nb_cases; c++) if (ref[c] > max_case) max_case = ref[c];
+    printf("%d cases, entrée %s (case la plus remplie: %.1f%% des valeurs)\n",
+           nb_cases, nom_entree, 100.0 * max_case / n);
+    printf("   %-22s", "M valeurs/s");
+    for (int t = 1; t <= max_threads; t *= 2) printf(" %8d th", t);
+    printf("\n");
+
+    int erreurs = 0;
+    int gagnante = 0;
+    double meilleur = 0.0;
+    for (int s = 0; s < NB_STRATEGIES; s++) {
+        printf("   %-22s", noms[s]);
+        double debit = 0.0;
+        for (int t = 1; t <= max_threads; t *= 2) {
+            if (strategies[s] == histo_reduction && nb_cases > HISTO_REDUCTION_MAX_CASES) {
+                printf(" %10s ", "(pile)");
+                debit = 0.0;
+                continue;
+            }
+            // Partition: hist neuf, placé par tranche pour ces t threads
+            long *h = hist;
+            if (strategies[s] == histo_partitionne) {
+                h = histo_allouer_partitionne(nb_cases, t);
+                if (h == NULL) {
+                    printf(" %10s ", "(mémoire)");
+                    erreurs++;
+                    continue;
+                }
+            }
+            strategies[s](valeurs, n, h, nb_cases, t);   // Échauffement
+            double start = omp_get_wtime();
+            strategies[s](valeurs, n, h, nb_cases, t);
+            double temps = omp_get_wtime() - start;
+            int ok = (memcmp(h, ref, nb_cases * sizeof(long)) == 0);
+            if (!ok) erreurs++;
+            if (h != hist) free(h);
+            debit = n / temps * 1e-6;
+            printf(" %10.1f%s", debit, ok ? " " : "✗");
+        }
+        printf("\n");
+        // Gagnante: au plus grand nombre de threads mesuré
+        if (debit > meilleur) {
+            meilleur = debit;
+            gagnante = s;
+        }
+    }
+    printf("   → Gagnante: %s\n\n", noms[gagnante]);
+
+    free(ref);
+    free(hist);
+    return erreurs;
+}
+
+int main(int argc, char *argv[]) {
+    long n = (argc > 1) ? (long)strtod(argv[1], NULL) : 50000000L;
+    int max_threads = omp_get_max_threads() * 2;
+    if (max_threads > HISTO_MAX_THREADS) max_threads = HISTO_MAX_THREADS;
+
+    printf("================================================================================\n");
+    printf("  HISTOGRAMMES PARALLÈLES: atomiques partagées vs copies privées\n");
+    printf("================================================================================\n");
+    printf("Valeurs: %ld (%.1f Mo) | Cœurs: %d\n\n", n, n * sizeof(uint32_t) / 1e6,
+           omp_get_num_procs());
+
+    uint32_t *valeurs = (uint32_t*)malloc(n * sizeof(uint32_t));
+    if (!valeurs) {
+        fprintf(stderr, "Erreur: Mémoire insuffisante (%.1f Go)\n", n * sizeof(uint32_t) / 1e9);
+        return 1;
+    }
+
+    int tailles[2] = {256, 1 << 20};
+    int erreurs = 0;
+    int numero = 1;
+    for (int k = 0; k < 2; k++) {
+        for (int biaise = 0; biaise <= 1; biaise++) {
+            printf("%d. ", numero++);
+            generer(valeurs, n, tailles[k], biaise);
+            erreurs += regime(valeurs, n, tailles[k], biaise ? "biaisée" : "uniforme",
+                              max_threads);
+        }
+    }
+    free(valeurs);
+
+    printf("================================================================================\n");
+    printf("ANALYSE\n");
+    printf("================================================================================\n");
+    printf("- 256 cases: les copies privées tiennent en L1 et la fusion est\n");
+    printf("  négligeable; les atomiques se battent pour 32 lignes de cache\n");
+    printf("- Entrée biaisée: avec les atomiques, tous les threads visent la même\n");
+    printf("  ligne (effondrement); les copies privées n'y sont pas sensibles\n");
+    printf("- 1M cases: copies de 8 Mo par thread (mise à zéro + fusion de T x 8 Mo),\n");
+    printf("  les atomiques uniformes ont peu de conflits et redeviennent compétitives\n");
+    printf("- reduction(+:hist[:]): copies sur la pile, inutilisable pour 1M cases\n");
+    printf("- Partition vs arbre: fusion en parallèle sur tous les threads au lieu de\n");
+    printf("  log2(T) étapes, et écritures locales au nœud NUMA (hist placé par\n");
+    printf("  tranche avec histo_allouer_partitionne)\n");
+    if (erreurs) printf("\n✗ %d histogramme(s) faux\n", erreurs);
+
+    return erreurs != 0;
+}
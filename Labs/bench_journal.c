@@ -0,0 +1,152 @@
+/*
+ * BENCHMARK: Journal binaire asynchrone (journal.h) vs printf
+ *
+ * Chaque thread écrit N messages (3 arguments) depuis une boucle chaude:
+ *   - fprintf + critical    : ce que font les labs avec printf
+ *   - fprintf seul          : verrou interne du FILE, formatage sur place
+ *   - JOURNAL               : anneau par thread + écrivain en arrière-plan
+ * On mesure les ns par message vus par le thread qui journalise, puis on
+ * relit le journal binaire pour vérifier qu'aucun message n'est perdu.
+ *
+ * Usage: ./bench_journal [messages_par_thread]     (défaut: 1e5)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <omp.h>
+#include "journal.h"
+
+#define FICHIER_TEXTE "bench_journal.log"
+#define FICHIER_JOURNAL "bench_journal.journal"
+
+enum { M_CRITICAL, M_FPRINTF, M_JOURNAL, NB_METHODES };
+static const char *noms[NB_METHODES] = {
+    "fprintf + critical", "fprintf (FILE)", "JOURNAL"
+};
+
+// Travail de la boucle chaude entre deux messages
+static double calcul(long i) {
+    double x = (double)i;
+    for (int k = 0; k < 10; k++) x = x * 0.999 + 1.0;
+    return x;
+}
+
+typedef struct {
+    double ns_par_message;
+    double temps_fermeture;   // JOURNAL: vidage final par l'écrivain (s)
+    uint64_t perdus;
+    long decodes;
+} Resultat;
+
+static Resultat mesurer(int m, int nb_threads, long n) {
+    Resultat r = {0.0, 0.0, 0, 0};
+    FILE *texte = NULL;
+    Journal j;
+    if (m != M_JOURNAL) texte = fopen(FICHIER_TEXTE, "w");
+    if (m == M_JOURNAL && journal_ouvrir(&j, FICHIER_JOURNAL, nb_threads, 1 << 16) != 0) {
+        r.decodes = -1;
+        return r;
+    }
+    if (m != M_JOURNAL && texte == NULL) {
+        fprintf(stderr, "Erreur: Impossible de créer le fichier %s\n", FICHIER_TEXTE);
+        r.decodes = -1;
+        return r;
+    }
+
+    double somme = 0.0;
+    double start = omp_get_wtime();
+    #pragma omp parallel num_threads(nb_threads) reduction(+:somme)
+    {
+        int id = omp_get_thread_num();
+        for (long i = 0; i < n; i++) {
+            double x = calcul(i);
+            somme += x;
+            switch (m) {
+            case M_CRITICAL:
+                #pragma omp critical
+                fprintf(texte, "thread %d: i = %ld, x = %.3f\n", id, i, x);
+                break;
+            case M_FPRINTF:
+                fprintf(texte, "thread %d: i = %ld, x = %.3f\n", id, i, x);
+                break;
+            default:
+                JOURNAL(&j, id, "thread %d: i = %ld, x = %.3f", id, i, x);
+                break;
+            }
+        }
+    }
+    double temps = omp_get_wtime() - start;
+    r.ns_par_message = temps / n * 1e9;
+
+    start = omp_get_wtime();
+    if (m == M_JOURNAL) {
+        r.perdus = journal_fermer(&j);
+        r.temps_fermeture = omp_get_wtime() - start;
+        FILE *nul = fopen("/dev/null", "w");
+        r.decodes = journal_decoder(FICHIER_JOURNAL, nul ? nul : stderr);
+        if (nul) fclose(nul);
+        // Le message final "perdus" s'ajoute aux messages reçus
+        if (r.perdus > 0) r.decodes--;
+    } else {
+        fclose(texte);
+        r.decodes = (long)n * nb_threads;
+    }
+    if (somme < 0) fprintf(stderr, "%f\n", somme);
+    return r;
+}
+
+int main(int argc, char *argv[]) {
+    long n = (argc > 1) ? (long)strtod(argv[1], NULL) : 100000L;
+    int max_threads = omp_get_max_threads() * 2;
+    int erreurs = 0;
+
+    int threads[32], nb_t = 0;
+    for (int t = 1; t <= max_threads && nb_t < 32; t *= 2) threads[nb_t++] = t;
+
+    printf("================================================================================\n");
+    printf("  JOURNALISATION: fprintf + critical vs fprintf vs journal binaire asynchrone\n");
+    printf("================================================================================\n");
+    printf("Cœurs: %d | Messages par thread: %ld | Enregistrement: %zu octets\n\n",
+           omp_get_num_procs(), n, sizeof(JournalEnregistrement));
+
+    // ------------------------------------------------------------------------
+    printf("1. COÛT PAR MESSAGE (ns, temps d'un thread / messages de ce thread)\n");
+    printf("   %-18s", "Méthode");
+    for (int k = 0; k < nb_t; k++) printf(" %7d th", threads[k]);
+    printf("\n");
+    Resultat res[NB_METHODES][32];
+    for (int m = 0; m < NB_METHODES; m++) {
+        for (int k = 0; k < nb_t; k++) res[m][k] = mesurer(m, threads[k], n);
+        printf("   %-18s", noms[m]);
+        for (int k = 0; k < nb_t; k++) printf(" %10.1f", res[m][k].ns_par_message);
+        printf("\n");
+    }
+    printf("\n");
+
+    // ------------------------------------------------------------------------
+    printf("2. JOURNAL: VÉRIFICATION APRÈS DÉCODAGE\n");
+    for (int k = 0; k < nb_t; k++) {
+        Resultat *r = &res[M_JOURNAL][k];
+        long attendus = n * threads[k];
+        int ok = (r->decodes + (long)r->perdus == attendus);
+        if (!ok) erreurs++;
+        printf("   %3d threads: %ld décodés + %lu perdus = %ld %s | vidage final %.2f ms\n",
+               threads[k], r->decodes, (unsigned long)r->perdus, attendus, ok ? "✓" : "✗",
+               r->temps_fermeture * 1e3);
+    }
+
+    printf("\n================================================================================\n");
+    printf("ANALYSE\n");
+    printf("================================================================================\n");
+    printf("- printf/fprintf + critical: formatage + appel système sous le verrou, les\n");
+    printf("  threads passent l'un après l'autre (le coût croît avec les threads)\n");
+    printf("- fprintf: le verrou du FILE sérialise aussi, le formatage reste sur\n");
+    printf("  le chemin critique du calcul\n");
+    printf("- JOURNAL: 64 octets copiés dans l'anneau du thread, aucune ligne\n");
+    printf("  partagée; formatage et write() déplacés vers l'écrivain et le décodeur\n");
+    printf("- Messages perdus: l'anneau déborde si l'écrivain n'a pas de cœur\n");
+    printf("  (plus de threads que de cœurs); augmenter la capacité de l'anneau\n");
+    printf("Décodage: ./journal_lire %s\n", FICHIER_JOURNAL);
+
+    return erreurs != 0;
+}
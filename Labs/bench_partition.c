@@ -0,0 +1,259 @@
+/*
+ * BENCHMARK: Initialisation par le master vs initialisation partitionnée
+ *
+ * Tableau de n int (1e8 à 1e9), trois façons de le préparer puis de le
+ * sommer avec la même partition statique:
+ *   - master seul        : exemple_initialisation d'origine (le master
+ *                          alloue et remplit, les autres attendent)
+ *   - single + for static: init et calcul par deux "omp for" statiques
+ *   - partition.h        : partition_allouer + partition_tranche
+ *
+ * Mesures: temps d'init (premier contact compris), deux passes de calcul
+ * (la deuxième sans défauts de page), et le pourcentage de pages qui
+ * sont sur le nœud NUMA du thread qui les lit (move_pages). Sur une
+ * machine à un seul nœud, seule la différence d'init est visible.
+ *
+ * Usage: ./bench_partition [n_max]     (défaut: 1e9; tailles 1e8, 3e8, 1e9)
+ *        OMP_PROC_BIND=spread OMP_PLACES=cores ./bench_partition
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <sched.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <string.h>
+#include <sys/syscall.h>
+#include <omp.h>
+#include "partition.h"
+#include "memoire.h"
+
+#define NB_METHODES 3
+#define PAGES_TESTEES 16          // Pages échantillonnées par thread
+
+enum { M_MASTER, M_FOR_STATIC, M_PARTITION };
+static const char *noms[NB_METHODES] = {"master seul", "single + for static", "partition.h"};
+
+static inline int valeur(size_t i) { return (int)(i & 0xFFFF) * 2; }
+
+typedef struct {
+    double init, calcul1, calcul2;    // s
+    long long somme1, somme2;         // Une somme par passe
+    long pages_locales, pages_testees;
+    int echec_allocation;
+} Resultat;
+
+static int nb_noeuds_numa(void) {
+    DIR *d = opendir("/sys/devices/system/node");
+    if (d == NULL) return 1;
+    int nb = 0;
+    struct dirent *e;
+    while ((e = readdir(d)) != NULL) {
+        if (strncmp(e->d_name, "node", 4) == 0 && e->d_name[4] >= '0' && e->d_name[4] <= '9') nb++;
+    }
+    closedir(d);
+    return nb > 0 ? nb : 1;
+}
+
+// Pages de [debut, fin) sur le nœud du thread courant (move_pages sans
+// destination = simple requête)
+static void compter_pages_locales(const int *d, size_t debut, size_t fin,
+                                  long *locales, long *testees) {
+    unsigned cpu, noeud;
+    if (fin <= debut || getcpu(&cpu, &noeud) != 0) return;
+    void *pages[PAGES_TESTEES];
+    int statut[PAGES_TESTEES];
+    int nb = 0;
+    for (int k = 0; k < PAGES_TESTEES; k++) {
+        size_t i = debut + (fin - debut) * k / PAGES_TESTEES;
+        pages[nb++] = (void*)((uintptr_t)&d[i] & ~(uintptr_t)(PARTITION_PAGE - 1));
+    }
+    if (syscall(SYS_move_pages, 0, (unsigned long)nb, pages, NULL, statut, 0) != 0) return;
+    for (int k = 0; k < nb; k++) {
+        if (statut[k] < 0) continue;
+        (*testees)++;
+        if ((unsigned)statut[k] == noeud) (*locales)++;
+    }
+}
+
+static long long sommer(const int *d, size_t debut, size_t fin) {
+    long long s = 0;
+    for (size_t i = debut; i < fin; i++) s += d[i];
+    return s;
+}
+
+static Resultat mesurer(int m, size_t n) {
+    Resultat r = {0.0, 0.0, 0.0, 0, 0, 0, 0, 0};
+    int *d = NULL;
+    long long somme1 = 0, somme2 = 0;
+    long locales = 0, testees = 0;
+    double t0 = 0.0, t1 = 0.0, t2 = 0.0, t3 = 0.0;
+
+    #pragma omp parallel reduction(+:locales, testees)
+    {
+        #pragma omp master
+        t0 = omp_get_wtime();
+        size_t debut, fin;
+
+        // ---- Allocation + initialisation --------------------------------
+        if (m == M_MASTER) {
+            #pragma omp master
+            {
+                d = (int*)malloc(n * sizeof(int));
+                if (d != NULL) {
+                    for (size_t i = 0; i < n; i++) d[i] = valeur(i);
+                }
+            }
+            #pragma omp barrier
+        } else if (m == M_FOR_STATIC) {
+            #pragma omp single
+            d = (int*)malloc(n * sizeof(int));
+            if (d != NULL) {
+                #pragma omp for schedule(static)
+                for (size_t i = 0; i < n; i++) d[i] = valeur(i);
+            }
+        } else {
+            int *p = (int*)partition_allouer(n * sizeof(int));
+            #pragma omp single nowait
+            d = p;
+            if (p != NULL) {
+                partition_tranche(n, sizeof(int), &debut, &fin);
+                for (size_t i = debut; i < fin; i++) p[i] = valeur(i);
+            }
+            #pragma omp barrier
+        }
+        #pragma omp master
+        t1 = omp_get_wtime();
+
+        // ---- Deux passes de calcul, même partition que l'init -----------
+        if (d != NULL) {
+            if (m == M_FOR_STATIC) {
+                // Même nombre d'itérations et même équipe: même répartition
+                for (int passe = 0; passe < 2; passe++) {
+                    long long s = 0;
+                    #pragma omp for schedule(static)
+                    for (size_t i = 0; i < n; i++) s += d[i];
+                    #pragma omp master
+                    {
+                        if (passe == 0) t2 = omp_get_wtime();
+                        else t3 = omp_get_wtime();
+                    }
+                    // atomic plutôt que reduction: GCC accumulerait
+                    // directement dans la copie privée, en mémoire
+                    if (passe == 0) {
+                        #pragma omp atomic
+                        somme1 += s;
+                    } else {
+                        #pragma omp atomic
+                        somme2 += s;
+                    }
+                }
+                size_t nb = (size_t)omp_get_num_threads(), id = (size_t)omp_get_thread_num();
+                debut = n * id / nb;
+                fin = n * (id + 1) / nb;
+            } else {
+                partition_tranche(n, sizeof(int), &debut, &fin);
+                for (int passe = 0; passe < 2; passe++) {
+                    long long s = sommer(d, debut, fin);
+                    #pragma omp barrier
+                    #pragma omp master
+                    {
+                        if (passe == 0) t2 = omp_get_wtime();
+                        else t3 = omp_get_wtime();
+                    }
+                    if (passe == 0) {
+                        #pragma omp atomic
+                        somme1 += s;
+                    } else {
+                        #pragma omp atomic
+                        somme2 += s;
+                    }
+                }
+            }
+            compter_pages_locales(d, debut, fin, &locales, &testees);
+        }
+    }
+
+    r.echec_allocation = (d == NULL);
+    r.init = t1 - t0;
+    r.calcul1 = t2 - t1;
+    r.calcul2 = t3 - t2;
+    r.somme1 = somme1;
+    r.somme2 = somme2;
+    r.pages_locales = locales;
+    r.pages_testees = testees;
+    free(d);
+    return r;
+}
+
+int main(int argc, char *argv[]) {
+    size_t n_max = (argc > 1) ? (size_t)strtod(argv[1], NULL) : 1000000000UL;
+    size_t tailles[3] = {100000000UL, 300000000UL, 1000000000UL};
+    int erreurs = 0;
+
+    printf("================================================================================\n");
+    printf("  PREMIER CONTACT: initialisation par le master vs partition statique\n");
+    printf("================================================================================\n");
+    printf("Threads: %d | Nœuds NUMA: %d | Mémoire libre: %.1f Go\n\n",
+           omp_get_max_threads(), nb_noeuds_numa(), memoire_libre() / 1e9);
+
+    int section = 0, mesurees = 0;
+    for (int t = 0; t < 3; t++) {
+        size_t n = tailles[t];
+        if (n > n_max) continue;
+        printf("%d. n = %.0e int (%.1f Go)\n", ++section, (double)n, n * sizeof(int) / 1e9);
+        if (!memoire_suffisante(n * sizeof(int))) {
+            printf("   (mémoire insuffisante, ignoré)\n\n");
+            continue;
+        }
+        mesurees++;
+        printf("   %-21s %10s %12s %12s %10s %12s\n", "Méthode", "init (s)", "calcul 1 (s)",
+               "calcul 2 (s)", "Go/s", "pages loc.");
+
+        // Somme attendue: la valeur est périodique de période 65536
+        long long attendu = 0, periode = 0;
+        for (size_t i = 0; i < 65536; i++) periode += valeur(i);
+        attendu = periode * (long long)(n / 65536);
+        for (size_t i = n / 65536 * 65536; i < n; i++) attendu += valeur(i);
+
+        for (int m = 0; m < NB_METHODES; m++) {
+            Resultat r = mesurer(m, n);
+            if (r.echec_allocation) {
+                printf("   %-20s (allocation impossible)\n", noms[m]);
+                erreurs++;
+                continue;
+            }
+            int ok = (r.somme1 == attendu && r.somme2 == attendu);
+            if (!ok) erreurs++;
+            char pages[32] = "-";
+            if (r.pages_testees > 0) {
+                snprintf(pages, sizeof(pages), "%.0f%%", 100.0 * r.pages_locales / r.pages_testees);
+            }
+            printf("   %-20s %10.3f %12.3f %12.3f %10.2f %12s %s\n", noms[m], r.init, r.calcul1,
+                   r.calcul2, n * sizeof(int) / r.calcul2 / 1e9, pages, ok ? "✓" : "✗");
+        }
+        printf("\n");
+    }
+    if (mesurees == 0) {
+        fprintf(stderr, "Erreur: Aucune taille mesurée (n_max = %.0e, plus petite taille %.0e)\n",
+                (double)n_max, (double)tailles[0]);
+        return 1;
+    }
+
+    printf("================================================================================\n");
+    printf("ANALYSE\n");
+    printf("================================================================================\n");
+    printf("- master seul: init séquentielle (défauts de page compris) pendant\n");
+    printf("  que T-1 threads attendent à la barrière\n");
+    printf("- Premier contact: avec le master, toutes les pages sont sur SON nœud;\n");
+    printf("  les threads des autres sockets lisent à distance (pages loc. < 100%%,\n");
+    printf("  calcul 2 limité par le lien entre sockets)\n");
+    printf("- Init partitionnée: chaque page est écrite, donc placée, par le thread\n");
+    printf("  qui la lira; même partition pour l'init et le calcul\n");
+    printf("- Épingler les threads (OMP_PROC_BIND) sinon un thread peut migrer\n");
+    printf("  loin de ses pages\n");
+
+    return erreurs != 0;
+}
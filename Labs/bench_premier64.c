@@ -0,0 +1,151 @@
+/*
+ * BENCHMARK: Test de primalité 64 bits par lots (premier64.h)
+ *
+ * 1. Validation: comparaison avec Ératosthène jusqu'à 1e7 et cas difficiles
+ *    (Carmichael, pseudo-premiers forts, plus grand premier 64 bits)
+ * 2. Débit sur des uint64_t aléatoires: scalaire vs 4 entrelacés
+ * 3. Scaling avec le nombre de threads
+ *
+ * Usage: ./bench_premier64 [nb_candidats]     (défaut: 10000000)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <omp.h>
+#include "premier64.h"
+
+// Générateur splitmix64 (reproductible)
+static uint64_t splitmix64(uint64_t *etat) {
+    uint64_t z = (*etat += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+static int valider_contre_crible(uint64_t limite) {
+    size_t nb = (size_t)limite + 1;
+    uint64_t *candidats = (uint64_t*)malloc(nb * sizeof(uint64_t));
+    uint8_t *resultats = (uint8_t*)malloc(nb);
+    for (size_t i = 0; i < nb; i++) candidats[i] = i;
+    premier64_test_lot(candidats, resultats, nb, omp_get_max_threads());
+
+    // Crible d'Ératosthène de référence
+    uint8_t *crible = (uint8_t*)malloc(nb);
+    memset(crible, 1, nb);
+    crible[0] = 0;
+    if (nb > 1) crible[1] = 0;
+    for (uint64_t p = 2; p * p <= limite; p++) {
+        if (!crible[p]) continue;
+        for (uint64_t k = p * p; k <= limite; k += p) crible[k] = 0;
+    }
+
+    int erreurs = 0;
+    for (uint64_t i = 0; i <= limite; i++) {
+        if (resultats[i] != crible[i]) {
+            if (erreurs < 5) {
+                printf("   ✗ %llu: obtenu %d, attendu %d\n",
+                       (unsigned long long)i, resultats[i], crible[i]);
+            }
+            erreurs++;
+        }
+    }
+    free(crible);
+    free(candidats);
+    free(resultats);
+    return erreurs;
+}
+
+static void mesurer(const char *nom, const uint64_t *candidats, uint8_t *resultats,
+                    size_t nb, int num_threads, int entrelace) {
+    double start = omp_get_wtime();
+    if (entrelace) premier64_test_lot(candidats, resultats, nb, num_threads);
+    else premier64_test_lot_scalaire(candidats, resultats, nb, num_threads);
+    double temps = omp_get_wtime() - start;
+
+    size_t premiers = 0;
+    for (size_t i = 0; i < nb; i++) premiers += resultats[i];
+    printf("   %-26s Threads: %2d | Premiers: %8zu | Temps: %.4f s | %.2f M candidats/s\n",
+           nom, num_threads, premiers, temps, nb / temps * 1e-6);
+}
+
+int main(int argc, char *argv[]) {
+    size_t nb = (argc > 1) ? (size_t)strtod(argv[1], NULL) : 10000000;
+
+    printf("================================================================================\n");
+    printf("  TEST DE PRIMALITÉ 64 BITS PAR LOTS (Miller-Rabin déterministe + Montgomery)\n");
+    printf("================================================================================\n\n");
+
+    // ---------------------------------------------------------------------
+    printf("1. VALIDATION\n");
+    int erreurs = valider_contre_crible(10000000);
+    printf("   Comparaison avec Ératosthène jusqu'à 1e7: %s\n",
+           erreurs == 0 ? "✓ identique" : "✗ ERREURS");
+
+    struct { uint64_t n; int premier; const char *desc; } cas[] = {
+        {561, 0, "Carmichael 561"},
+        {3215031751ull, 0, "pseudo-premier fort bases 2,3,5,7"},
+        {3825123056546413051ull, 0, "pseudo-premier fort bases 2..23"},
+        {2305843009213693951ull, 1, "2^61 - 1 (Mersenne)"},
+        {18446744073709551557ull, 1, "2^64 - 59 (plus grand premier 64 bits)"},
+        {18446744073709551615ull, 0, "2^64 - 1"},
+        {4294967291ull * 4294967279ull, 0, "produit de deux premiers 32 bits"},
+    };
+    int nb_cas = (int)(sizeof(cas) / sizeof(cas[0]));
+    uint64_t lot[8];
+    uint8_t res_lot[8];
+    for (int i = 0; i < nb_cas; i++) lot[i] = cas[i].n;
+    premier64_test_lot(lot, res_lot, nb_cas, 1);
+    for (int i = 0; i < nb_cas; i++) {
+        int ok = (res_lot[i] == cas[i].premier) &&
+                 (premier64_est_premier(cas[i].n) == cas[i].premier);
+        if (!ok) erreurs++;
+        printf("   %-42s %20llu -> %s %s\n", cas[i].desc, (unsigned long long)cas[i].n,
+               res_lot[i] ? "premier" : "composé ", ok ? "✓" : "✗");
+    }
+    printf("\n");
+
+    // ---------------------------------------------------------------------
+    uint64_t *candidats = (uint64_t*)malloc(nb * sizeof(uint64_t));
+    uint8_t *resultats = (uint8_t*)malloc(nb);
+    uint64_t etat = 42;
+    int max_threads = omp_get_max_threads();
+
+    printf("2. DÉBIT: %zu uint64_t aléatoires\n", nb);
+    for (size_t i = 0; i < nb; i++) candidats[i] = splitmix64(&etat);
+    mesurer("Scalaire", candidats, resultats, nb, 1, 0);
+    mesurer("4 entrelacés", candidats, resultats, nb, 1, 1);
+    printf("\n");
+
+    printf("   %zu impairs aléatoires sans facteur < 50 (Miller-Rabin seul)\n", nb);
+    for (size_t i = 0; i < nb; i++) {
+        uint64_t c;
+        do {
+            c = splitmix64(&etat) | 1;
+        } while (premier64_petits(c) != PREMIER64_INDECIS);
+        candidats[i] = c;
+    }
+    mesurer("Scalaire", candidats, resultats, nb, 1, 0);
+    mesurer("4 entrelacés", candidats, resultats, nb, 1, 1);
+    printf("\n");
+
+    // ---------------------------------------------------------------------
+    printf("3. SCALING (impairs sans petit facteur, 4 entrelacés)\n");
+    for (int t = 1; t <= max_threads * 2; t *= 2) {
+        mesurer("4 entrelacés", candidats, resultats, nb, t, 1);
+    }
+    printf("\n");
+
+    free(candidats);
+    free(resultats);
+
+    printf("================================================================================\n");
+    printf("ANALYSE\n");
+    printf("================================================================================\n");
+    printf("- Montgomery remplace la division 128 bits par 2 multiplications\n");
+    printf("- Entrelacer 4 candidats masque la latence de la multiplication 64x64\n");
+    printf("- Les petits premiers éliminent la majorité des candidats aléatoires\n");
+    printf("- 7 bases suffisent pour un résultat exact sur tout uint64_t\n");
+
+    return erreurs != 0;
+}
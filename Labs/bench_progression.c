@@ -0,0 +1,158 @@
+/*
+ * BENCHMARK: Coût de la progression (progression.h) sur les boucles réelles
+ *
+ * Les deux boucles longues du dépôt, avec et sans suivi (rappel
+ * progression_rappel passé aux noyaux eux-mêmes):
+ *   1. Matrice (matrix lab/matrix.h): matrix_mult_parallel_static_suivi,
+ *      un appel par ligne de C
+ *   2. Crible segmenté (crible.h): count_primes_crible_segmente_suivi,
+ *      un appel par segment de CRIBLE_SEGMENT_NOMBRES nombres
+ * Les variantes sont entrelacées, REPETITIONS fois, on garde le minimum;
+ * l'écart entre le pire et le meilleur temps sans suivi donne le bruit.
+ * Le moniteur affiche sur stderr (rediriger 2>/dev/null pour ne voir que
+ * le tableau); une période courte (10 ms) sert de cas défavorable.
+ *
+ * Usage: ./bench_progression [n_matrice] [n_crible]   (défaut: 800, 1e9)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <omp.h>
+#include "progression.h"
+#include "crible.h"
+#include "matrix lab/matrix.h"
+
+#define REPETITIONS 5
+#define MATRICE_CHUNK 16            // Recommandation de matrix.c
+
+// ============================================================================
+// MESURES
+// ============================================================================
+
+typedef struct {
+    int n;
+    double **A, **B, **C;
+    uint64_t n_crible;
+    uint64_t resultat;
+} Contexte;
+
+// periode <= 0: sans suivi
+static double mesurer(Contexte *c, int noyau, double periode) {
+    Progression p;
+    Progression *suivi = NULL;
+    if (periode > 0) {
+        long total = noyau ? (long)crible_nb_segments(c->n_crible) : c->n;
+        if (progression_demarrer(&p, noyau ? "crible" : "matrice", total,
+                                 omp_get_max_threads(), periode) == 0) {
+            suivi = &p;
+        }
+    }
+    void (*avancer)(void*, int, long) = suivi ? progression_rappel : NULL;
+    double start = omp_get_wtime();
+    if (noyau == 0) {
+        matrix_mult_parallel_static_suivi(c->A, c->B, c->C, c->n, omp_get_max_threads(),
+                                          MATRICE_CHUNK, avancer, suivi);
+        c->resultat = (uint64_t)c->C[c->n / 2][c->n / 3];
+    } else {
+        c->resultat = count_primes_crible_segmente_suivi(c->n_crible, omp_get_max_threads(),
+                                                         avancer, suivi);
+    }
+    double temps = omp_get_wtime() - start;
+    if (suivi != NULL) progression_terminer(suivi);
+    return temps;
+}
+
+static double **allouer(int n) {
+    double **m = (double**)malloc(n * sizeof(double*));
+    for (int i = 0; i < n; i++) m[i] = (double*)malloc(n * sizeof(double));
+    return m;
+}
+
+static void liberer(double **m, int n) {
+    for (int i = 0; i < n; i++) free(m[i]);
+    free(m);
+}
+
+int main(int argc, char *argv[]) {
+    Contexte c;
+    c.n = (argc > 1) ? atoi(argv[1]) : 800;
+    c.n_crible = (argc > 2) ? (uint64_t)strtod(argv[2], NULL) : 1000000000ULL;
+    if (c.n < 1 || c.n_crible < 2) {
+        fprintf(stderr, "Erreur: Tailles invalides\n");
+        return 1;
+    }
+    c.A = allouer(c.n);
+    c.B = allouer(c.n);
+    c.C = allouer(c.n);
+    for (int i = 0; i < c.n; i++) {
+        for (int j = 0; j < c.n; j++) {
+            c.A[i][j] = (double)(i + j) / c.n;
+            c.B[i][j] = (double)(i - j) / c.n;
+        }
+    }
+
+    printf("================================================================================\n");
+    printf("  PROGRESSION: surcoût du suivi sur la matrice et le crible\n");
+    printf("================================================================================\n");
+    printf("Threads: %d | Matrice: %dx%d (%d lignes) | Crible: %.0e (%lu segments)\n",
+           omp_get_max_threads(), c.n, c.n, c.n, (double)c.n_crible,
+           (unsigned long)crible_nb_segments(c.n_crible));
+    printf("Meilleur de %d répétitions; le moniteur écrit sur stderr\n\n", REPETITIONS);
+
+    const char *noms[2] = {"matrice", "crible"};
+    double periodes[3] = {0.0, 1.0, 0.01};      // 0: sans suivi
+    int erreurs = 0;
+    double pire_ecart = -1e30, pire_bruit = 0.0;     // Période de 10 ms
+    for (int noyau = 0; noyau < 2; noyau++) {
+        printf("%d. %s\n", noyau + 1, noyau ? "CRIBLE SEGMENTÉ (un appel par segment)"
+                                           : "MATRICE (un appel par ligne)");
+        // Variantes entrelacées: une dérive de la machine les touche toutes
+        double meilleur[3] = {1e30, 1e30, 1e30};
+        double pire_sans_suivi = 0.0;
+        uint64_t attendu = 0;
+        for (int r = 0; r < REPETITIONS; r++) {
+            for (int k = 0; k < 3; k++) {
+                double t = mesurer(&c, noyau, periodes[k]);
+                if (r == 0 && k == 0) attendu = c.resultat;
+                if (c.resultat != attendu) erreurs++;
+                if (t < meilleur[k]) meilleur[k] = t;
+                if (k == 0 && t > pire_sans_suivi) pire_sans_suivi = t;
+            }
+        }
+        double bruit = (pire_sans_suivi / meilleur[0] - 1.0) * 100.0;
+        double ecart = (meilleur[2] / meilleur[0] - 1.0) * 100.0;
+        if (ecart - bruit > pire_ecart - pire_bruit) {
+            pire_ecart = ecart;
+            pire_bruit = bruit;
+        }
+        printf("   %-24s %9.4f s | bruit %.2f%%\n", "sans suivi", meilleur[0], bruit);
+        for (int k = 1; k < 3; k++) {
+            printf("   période %-6.2f s        %9.4f s | %+6.2f%%\n", periodes[k], meilleur[k],
+                   (meilleur[k] / meilleur[0] - 1.0) * 100.0);
+        }
+        printf("   (%s: résultat %lu, identique avec suivi %s)\n\n", noms[noyau],
+               (unsigned long)attendu, erreurs ? "✗" : "✓");
+    }
+
+    printf("================================================================================\n");
+    printf("ANALYSE\n");
+    printf("================================================================================\n");
+    printf("- Un appel par ligne/segment: un load + un store sur une ligne de cache\n");
+    printf("  privée, négligeable devant des µs ou ms de calcul\n");
+    printf("- Aucune ligne partagée écrite par les workers: pas de faux partage,\n");
+    printf("  contrairement à un compteur atomique commun\n");
+    printf("- Le moniteur dort entre deux mesures: un réveil par période\n");
+    if (pire_ecart <= pire_bruit) {
+        printf("- À 10 ms, l'écart (%+.2f%%) reste dans le bruit de mesure (%.2f%%)\n",
+               pire_ecart, pire_bruit);
+    } else {
+        printf("- À 10 ms, l'écart (%+.2f%%) dépasse le bruit de mesure (%.2f%%):\n",
+               pire_ecart, pire_bruit);
+        printf("  allonger la période ou appeler progression_avancer moins souvent\n");
+    }
+
+    liberer(c.A, c.n);
+    liberer(c.B, c.n);
+    liberer(c.C, c.n);
+    return erreurs != 0;
+}
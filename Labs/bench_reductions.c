@@ -0,0 +1,182 @@
+/*
+ * BENCHMARK: Réductions définies par l'utilisateur (reductions.h)
+ *
+ * Une passe avec un accumulateur structure vs plusieurs passes avec les
+ * réductions intégrées (min, max, +):
+ * 1. min + max           : reduction(minmax)  vs reduction(min) puis reduction(max)
+ * 2. résumé complet      : reduction(resume)  vs argmin, argmax, somme, écarts (4 passes)
+ * 3. top-k               : reduction(topk), vérifié contre 1 thread
+ * 4. Scaling du résumé avec le nombre de threads
+ *
+ * Usage: ./bench_reductions [nb_elements]     (défaut: 1e8 = 800 Mo; 1e9 = 8 Go)
+ *        (refusé si plus de 80% de la mémoire libre, cf. memoire.h)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <math.h>
+#include <omp.h>
+#include "reductions.h"
+#include "memoire.h"
+
+static uint64_t splitmix64(uint64_t *etat) {
+    uint64_t z = (*etat += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+// ============================================================================
+// PASSES SÉPARÉES (réductions intégrées d'OpenMP)
+// ============================================================================
+
+static double passe_min(const double *a, long n, int t) {
+    double m = INFINITY;
+    #pragma omp parallel for reduction(min:m) schedule(static) num_threads(t)
+    for (long i = 0; i < n; i++) m = (a[i] < m) ? a[i] : m;
+    return m;
+}
+
+static double passe_max(const double *a, long n, int t) {
+    double m = -INFINITY;
+    #pragma omp parallel for reduction(max:m) schedule(static) num_threads(t)
+    for (long i = 0; i < n; i++) m = (a[i] > m) ? a[i] : m;
+    return m;
+}
+
+static double passe_somme(const double *a, long n, int t) {
+    double s = 0.0;
+    #pragma omp parallel for simd reduction(+:s) schedule(static) num_threads(t)
+    for (long i = 0; i < n; i++) s += a[i];
+    return s;
+}
+
+static double passe_ecarts(const double *a, long n, double moyenne, int t) {
+    double s = 0.0;
+    #pragma omp parallel for simd reduction(+:s) schedule(static) num_threads(t)
+    for (long i = 0; i < n; i++) {
+        double d = a[i] - moyenne;
+        s += d * d;
+    }
+    return s;
+}
+
+static void afficher(const char *nom, int passes, double temps, long n) {
+    printf("   %-34s %d passe%s | %.4f s | %7.2f GB/s lus | %7.1f M éléments/s\n",
+           nom, passes, passes > 1 ? "s" : " ", temps,
+           passes * (double)n * sizeof(double) / temps * 1e-9, n / temps * 1e-6);
+}
+
+int main(int argc, char *argv[]) {
+    long n = (argc > 1) ? (long)strtod(argv[1], NULL) : 100000000L;
+    int t = omp_get_max_threads();
+    int erreurs = 0;
+
+    printf("================================================================================\n");
+    printf("  RÉDUCTIONS DÉFINIES PAR L'UTILISATEUR (declare reduction)\n");
+    printf("================================================================================\n");
+    printf("Éléments: %ld (%.1f Mo) | Threads: %d\n\n", n, n * sizeof(double) / 1e6, t);
+
+    double *a = memoire_suffisante(n * sizeof(double)) ? (double*)malloc(n * sizeof(double)) : NULL;
+    if (!a) {
+        fprintf(stderr, "Erreur: Mémoire insuffisante (%.1f Go)\n", n * sizeof(double) / 1e9);
+        return 1;
+    }
+    #pragma omp parallel num_threads(t)
+    {
+        uint64_t etat = 12345 + 7919 * omp_get_thread_num();
+        #pragma omp for schedule(static)
+        for (long i = 0; i < n; i++) {
+            a[i] = (splitmix64(&etat) >> 11) * 0x1.0p-53;   // Uniforme [0, 1)
+        }
+    }
+    // Extrema plantés: le maximum apparaît deux fois, le premier doit gagner
+    long i_min = n / 3, i_max = n / 2;
+    a[i_min] = -1.0;
+    a[i_max] = 2.0;
+    a[n - 1] = 2.0;
+
+    double start, temps;
+
+    // ------------------------------------------------------------------------
+    printf("1. MIN + MAX\n");
+    start = omp_get_wtime();
+    double mn = passe_min(a, n, t);
+    double mx = passe_max(a, n, t);
+    temps = omp_get_wtime() - start;
+    afficher("reduction(min) + reduction(max)", 2, temps, n);
+
+    start = omp_get_wtime();
+    MinMax mm = reduire_minmax(a, n, t);
+    temps = omp_get_wtime() - start;
+    afficher("reduction(minmax)", 1, temps, n);
+    int ok = (mm.min == mn && mm.max == mx);
+    if (!ok) erreurs++;
+    printf("   min = %g, max = %g %s\n\n", mm.min, mm.max, ok ? "✓" : "✗");
+
+    // ------------------------------------------------------------------------
+    printf("2. RÉSUMÉ: argmin, argmax, moyenne, variance\n");
+    start = omp_get_wtime();
+    ArgVal amin = reduire_argmin(a, n, t);
+    ArgVal amax = reduire_argmax(a, n, t);
+    double moyenne = passe_somme(a, n, t) / n;
+    double variance = passe_ecarts(a, n, moyenne, t) / (n - 1);
+    temps = omp_get_wtime() - start;
+    afficher("argmin, argmax, somme, écarts", 4, temps, n);
+
+    start = omp_get_wtime();
+    Resume r = reduire_resume(a, n, t);
+    temps = omp_get_wtime() - start;
+    afficher("reduction(resume)", 1, temps, n);
+
+    double ecart_var = fabs(welford_variance(r.stats) - variance) / variance;
+    ok = r.min.indice == i_min && r.max.indice == i_max &&
+         amin.indice == i_min && amax.indice == i_max &&
+         fabs(r.stats.moyenne - moyenne) < 1e-12 && ecart_var < 1e-9;
+    if (!ok) erreurs++;
+    printf("   argmin = %ld, argmax = %ld (premier des deux maxima)\n", r.min.indice, r.max.indice);
+    printf("   moyenne = %.12f, variance = %.12f (écart relatif vs 2 passes: %.1e) %s\n\n",
+           r.stats.moyenne, welford_variance(r.stats), ecart_var, ok ? "✓" : "✗");
+
+    // ------------------------------------------------------------------------
+    printf("3. TOP-%d\n", REDUCTIONS_TOPK);
+    start = omp_get_wtime();
+    TopK tk = reduire_topk(a, n, t);
+    temps = omp_get_wtime() - start;
+    afficher("reduction(topk)", 1, temps, n);
+    TopK tk1 = reduire_topk(a, n, 1);
+    ok = (tk.nb == tk1.nb) && tk.indice[0] == i_max && tk.indice[1] == n - 1;
+    for (int k = 0; k < tk.nb && k < tk1.nb; k++) {
+        ok = ok && tk.valeur[k] == tk1.valeur[k] && tk.indice[k] == tk1.indice[k];
+    }
+    if (!ok) erreurs++;
+    printf("   ");
+    for (int k = 0; k < tk.nb; k++) printf("%.9f[%ld] ", tk.valeur[k], tk.indice[k]);
+    printf("%s\n\n", ok ? "✓" : "✗");
+
+    // ------------------------------------------------------------------------
+    printf("4. SCALING DU RÉSUMÉ\n");
+    double temps_ref = 0;
+    for (int nt = 1; nt <= t * 2; nt *= 2) {
+        start = omp_get_wtime();
+        Resume rs = reduire_resume(a, n, nt);
+        temps = omp_get_wtime() - start;
+        if (nt == 1) temps_ref = temps;
+        printf("   Threads: %2d | Temps: %.4f s | Speedup: %.2fx | argmax = %ld\n",
+               nt, temps, temps_ref / temps, rs.max.indice);
+    }
+    free(a);
+
+    printf("\n================================================================================\n");
+    printf("ANALYSE\n");
+    printf("================================================================================\n");
+    printf("- Les grands tableaux sont limités par la mémoire: 1 passe au lieu de k\n");
+    printf("  divise le trafic par k\n");
+    printf("- Welford par blocs: moyenne puis écarts relus depuis L1 (précision\n");
+    printf("  d'un calcul en 2 passes, trafic d'une seule)\n");
+    printf("- argmin/argmax: le plus petit indice gagne, résultat déterministe\n");
+    printf("- Top-k: une comparaison par élément dans le cas courant\n");
+
+    return erreurs != 0;
+}
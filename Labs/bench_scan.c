@@ -0,0 +1,146 @@
+/*
+ * BENCHMARK: Sommes préfixes parallèles (scan.h)
+ *
+ * 1. Validation: chaque algorithme, inclusif et exclusif, contre le scan
+ *    séquentiel (données entières: résultat exact même en flottant)
+ * 2. Débit en GB/s (lecture + écriture) comparé à une simple copie
+ *    pour int64, float et double
+ *
+ * Usage: ./bench_scan [nb_elements]     (défaut: 1e8)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <omp.h>
+#include "scan.h"
+
+#define NB_ALGOS 4
+static const char *noms_algos[NB_ALGOS] = {
+    "séquentiel", "deux passes", "regard en arrière", "omp scan"
+};
+
+// Mesure d'une copie (référence de bande passante)
+static double mesurer_copie(const void *in, void *out, size_t octets) {
+    void *(*volatile copier)(void*, const void*, size_t) = memcpy;
+    copier(out, in, octets);
+    double start = omp_get_wtime();
+    copier(out, in, octets);
+    return omp_get_wtime() - start;
+}
+
+// Génère validation + benchmark pour un type
+#define DEFINIR_BENCH(nom, type)                                                \
+static void lancer_##nom(int algo, const type *in, type *out, long n,           \
+                         int mode, int t) {                                     \
+    switch (algo) {                                                             \
+    case 0: scan_sequentiel_##nom(in, out, n, mode); break;                     \
+    case 1: scan_deux_passes_##nom(in, out, n, mode, t); break;                 \
+    case 2: scan_lookback_##nom(in, out, n, mode, t); break;                    \
+    default: scan_omp_##nom(in, out, n, mode, t); break;                        \
+    }                                                                           \
+}                                                                               \
+                                                                                \
+static int valider_##nom(long n, int t) {                                       \
+    type *in = (type*)malloc(n * sizeof(type));                                 \
+    type *ref = (type*)malloc(n * sizeof(type));                                \
+    type *out = (type*)malloc(n * sizeof(type));                                \
+    for (long i = 0; i < n; i++) in[i] = (type)(i % 7);                         \
+    int erreurs = 0;                                                            \
+    for (int mode = 0; mode <= 1; mode++) {                                     \
+        scan_sequentiel_##nom(in, ref, n, mode);                                \
+        for (int algo = 1; algo < NB_ALGOS; algo++) {                           \
+            memset(out, 0xFF, n * sizeof(type));                                \
+            lancer_##nom(algo, in, out, n, mode, t);                            \
+            if (memcmp(out, ref, n * sizeof(type)) != 0) {                      \
+                printf("   ✗ %s %s (%s)\n", #nom, noms_algos[algo],           \
+                       mode == SCAN_INCLUSIF ? "inclusif" : "exclusif");        \
+                erreurs++;                                                      \
+            }                                                                   \
+        }                                                                       \
+    }                                                                           \
+    free(in);                                                                   \
+    free(ref);                                                                  \
+    free(out);                                                                  \
+    return erreurs;                                                             \
+}                                                                               \
+                                                                                \
+static void bench_##nom(long n, int t) {                                        \
+    size_t octets = n * sizeof(type);                                           \
+    type *in = (type*)malloc(octets);                                           \
+    type *out = (type*)malloc(octets);                                          \
+    if (!in || !out) {                                                          \
+        printf("   %s: ⚠️  mémoire insuffisante, ignoré\n", #nom);              \
+        free(in);                                                               \
+        free(out);                                                              \
+        return;                                                                 \
+    }                                                                           \
+    _Pragma("omp parallel for num_threads(t)")                                  \
+    for (long i = 0; i < n; i++) in[i] = (type)(i % 7);                         \
+    double t_copie = mesurer_copie(in, out, octets);                            \
+    double gbs_copie = 2.0 * octets / t_copie * 1e-9;                           \
+    printf("   %-8s %-22s %-9s %10.4f s %8.2f GB/s %6.0f%%\n", #nom, "copie", "",  \
+           t_copie, gbs_copie, 100.0);                                          \
+    for (int mode = SCAN_INCLUSIF; mode >= SCAN_EXCLUSIF; mode--) {             \
+        for (int algo = 0; algo < NB_ALGOS; algo++) {                           \
+            lancer_##nom(algo, in, out, n, mode, t); /* Pages déjà touchées */  \
+            double start = omp_get_wtime();                                     \
+            lancer_##nom(algo, in, out, n, mode, t);                            \
+            double temps = omp_get_wtime() - start;                             \
+            double gbs = 2.0 * octets / temps * 1e-9;                           \
+            printf("   %-8s %-22s %-9s %10.4f s %8.2f GB/s %6.0f%%\n", #nom,    \
+                   noms_algos[algo],                                            \
+                   mode == SCAN_INCLUSIF ? "inclusif" : "exclusif",             \
+                   temps, gbs, 100.0 * gbs / gbs_copie);                        \
+        }                                                                       \
+    }                                                                           \
+    free(in);                                                                   \
+    free(out);                                                                  \
+}
+
+DEFINIR_BENCH(int64, int64_t)
+DEFINIR_BENCH(float, float)
+DEFINIR_BENCH(double, double)
+
+int main(int argc, char *argv[]) {
+    long n = (argc > 1) ? (long)strtod(argv[1], NULL) : 100000000L;
+    int t = omp_get_max_threads();
+
+    printf("================================================================================\n");
+    printf("  SOMMES PRÉFIXES PARALLÈLES (scan)\n");
+    printf("================================================================================\n");
+    printf("Threads: %d | Tuile (regard en arrière): %d éléments\n\n", t, SCAN_TUILE);
+
+    // Au moins 2 threads pour exercer l'attente entre tuiles; tailles non
+    // multiples de la tuile pour tester les bords
+    int t_valid = (t < 2) ? 2 : t;
+    printf("1. VALIDATION (%d threads, tailles 1, 1000, 100003, 1000003)\n", t_valid);
+    long tailles[] = {1, 1000, 100003, 1000003};
+    int erreurs = 0;
+    for (int k = 0; k < 4; k++) {
+        erreurs += valider_int64(tailles[k], t_valid);
+        erreurs += valider_float(tailles[k], t_valid);
+        erreurs += valider_double(tailles[k], t_valid);
+    }
+    printf("   %s\n\n", erreurs == 0 ? "✓ Tous les algorithmes donnent le résultat séquentiel"
+                                     : "✗ ERREURS");
+
+    printf("2. DÉBIT: %ld éléments (GB/s = octets lus + écrits)\n", n);
+    printf("   %-8s %-22s %-9s %12s %13s %7s\n", "Type", "Algorithme", "Mode", "Temps", "Débit", "/copie");
+    bench_int64(n, t);
+    printf("\n");
+    bench_float(n, t);
+    printf("\n");
+    bench_double(n, t);
+
+    printf("\n================================================================================\n");
+    printf("ANALYSE\n");
+    printf("================================================================================\n");
+    printf("- Deux passes: 2 lectures + 1 écriture, simple et sans attente\n");
+    printf("- Regard en arrière: 1 lecture + 1 écriture, la tuile est scannée en cache\n");
+    printf("- La copie est la borne: un scan ne peut pas faire moins de trafic\n");
+    printf("- omp scan: portable, performance dépendante du compilateur\n");
+
+    return erreurs != 0;
+}
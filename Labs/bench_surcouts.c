@@ -0,0 +1,426 @@
+/*
+ * BENCHMARK: Surcoût des constructions OpenMP (méthode EPCC)
+ *
+ * Test_OpenMP_Connaissances.c interroge sur barrier, single, critical,
+ * atomic, les schedules...; ici on mesure ce qu'ils coûtent réellement.
+ *
+ * Méthode (EPCC microbenchmarks, Bull et al.):
+ *   référence: innerreps appels de delay() par un seul thread
+ *   test     : innerreps fois la construction entourant delay()
+ *   surcoût  = (temps_test - temps_reference) / innerreps      (µs)
+ * delay() dure DELAI_US; innerreps est doublé jusqu'à ce qu'un test dure
+ * au moins TEMPS_CIBLE, puis on répète OUTERREPS fois (moyenne, écart
+ * type, minimum).
+ *
+ * Suites:
+ *   sync : parallel, for, parallel for, barrier, single, critical, lock,
+ *          atomic, reduction
+ *   sched: for avec schedule static/dynamic/guided, chunk 1 à 128
+ *          (ITERS_PAR_THREAD itérations par thread, surcoût par boucle)
+ *   task : tâches créées par tous les threads, par le maître, taskwait
+ *
+ * Sortie CSV (--csv): une ligne par mesure avec le compilateur, le runtime
+ * (libgomp ou libomp, détecté à l'exécution) et le nombre de threads, pour
+ * comparer compilateurs, runtimes et machines.
+ *
+ * Usage: ./bench_surcouts [sync|sched|task|tout] [--csv [fichier]]
+ *        (défaut: tout, CSV: surcouts.csv)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <dlfcn.h>
+#include <omp.h>
+
+#define DELAI_US 0.1
+#define TEMPS_CIBLE 2e-3          // Durée minimale d'un test (s)
+#define OUTERREPS 20
+#define ITERS_PAR_THREAD 1024
+
+static int longueur_delai;        // Itérations de delay() pour DELAI_US
+static int nb_threads;
+static int chunk_courant;
+static omp_lock_t verrou;
+static int compteur_atomique;
+
+// Boucle flottante: chaîne de dépendance non vectorisable (EPCC)
+static void delay(int longueur) {
+    float a = 0.0f;
+    for (int i = 0; i < longueur; i++) a += i;
+    if (a < 0) printf("%f\n", a);
+}
+
+// ============================================================================
+// RÉFÉRENCES
+// ============================================================================
+
+static void ref_delai(long reps) {
+    for (long j = 0; j < reps; j++) delay(longueur_delai);
+}
+
+static void ref_atomique(long reps) {
+    for (long j = 0; j < reps; j++) compteur_atomique += 1;
+}
+
+static void ref_reduction(long reps) {
+    int a = 0;
+    for (long j = 0; j < reps; j++) {
+        delay(longueur_delai);
+        a += 1;
+    }
+    compteur_atomique += a;
+}
+
+// Boucle de référence des schedules: les itérations d'un thread
+static void ref_boucle(long reps) {
+    for (long j = 0; j < reps; j++) {
+        for (int i = 0; i < ITERS_PAR_THREAD; i++) delay(longueur_delai);
+    }
+}
+
+// ============================================================================
+// SYNCBENCH
+// ============================================================================
+
+static void test_parallel(long reps) {
+    for (long j = 0; j < reps; j++) {
+        #pragma omp parallel
+        delay(longueur_delai);
+    }
+}
+
+static void test_for(long reps) {
+    #pragma omp parallel
+    for (long j = 0; j < reps; j++) {
+        #pragma omp for
+        for (int i = 0; i < nb_threads; i++) delay(longueur_delai);
+    }
+}
+
+static void test_parallel_for(long reps) {
+    for (long j = 0; j < reps; j++) {
+        #pragma omp parallel for
+        for (int i = 0; i < nb_threads; i++) delay(longueur_delai);
+    }
+}
+
+static void test_barrier(long reps) {
+    #pragma omp parallel
+    for (long j = 0; j < reps; j++) {
+        delay(longueur_delai);
+        #pragma omp barrier
+    }
+}
+
+static void test_single(long reps) {
+    #pragma omp parallel
+    for (long j = 0; j < reps; j++) {
+        #pragma omp single
+        delay(longueur_delai);
+    }
+}
+
+// critical/lock/atomic: reps sections au total, réparties entre les threads
+static void test_critical(long reps) {
+    #pragma omp parallel
+    for (long j = 0; j < reps / nb_threads; j++) {
+        #pragma omp critical
+        delay(longueur_delai);
+    }
+}
+
+static void test_lock(long reps) {
+    #pragma omp parallel
+    for (long j = 0; j < reps / nb_threads; j++) {
+        omp_set_lock(&verrou);
+        delay(longueur_delai);
+        omp_unset_lock(&verrou);
+    }
+}
+
+static void test_atomic(long reps) {
+    #pragma omp parallel
+    for (long j = 0; j < reps / nb_threads; j++) {
+        #pragma omp atomic
+        compteur_atomique += 1;
+    }
+}
+
+static void test_reduction(long reps) {
+    for (long j = 0; j < reps; j++) {
+        int a = 0;
+        #pragma omp parallel reduction(+:a)
+        {
+            delay(longueur_delai);
+            a += 1;
+        }
+        compteur_atomique += a;
+    }
+}
+
+// ============================================================================
+// SCHEDBENCH (chunk_courant fixé avant la mesure)
+// ============================================================================
+
+static void test_static_bloc(long reps) {
+    #pragma omp parallel
+    for (long j = 0; j < reps; j++) {
+        #pragma omp for schedule(static)
+        for (int i = 0; i < ITERS_PAR_THREAD * nb_threads; i++) delay(longueur_delai);
+    }
+}
+
+static void test_static(long reps) {
+    #pragma omp parallel
+    for (long j = 0; j < reps; j++) {
+        #pragma omp for schedule(static, chunk_courant)
+        for (int i = 0; i < ITERS_PAR_THREAD * nb_threads; i++) delay(longueur_delai);
+    }
+}
+
+static void test_dynamic(long reps) {
+    #pragma omp parallel
+    for (long j = 0; j < reps; j++) {
+        #pragma omp for schedule(dynamic, chunk_courant)
+        for (int i = 0; i < ITERS_PAR_THREAD * nb_threads; i++) delay(longueur_delai);
+    }
+}
+
+static void test_guided(long reps) {
+    #pragma omp parallel
+    for (long j = 0; j < reps; j++) {
+        #pragma omp for schedule(guided, chunk_courant)
+        for (int i = 0; i < ITERS_PAR_THREAD * nb_threads; i++) delay(longueur_delai);
+    }
+}
+
+// ============================================================================
+// TASKBENCH
+// ============================================================================
+
+// Chaque thread crée reps tâches: reps délais par thread
+static void test_taches_tous(long reps) {
+    #pragma omp parallel
+    for (long j = 0; j < reps; j++) {
+        #pragma omp task
+        delay(longueur_delai);
+    }
+}
+
+static void test_taches_maitre(long reps) {
+    #pragma omp parallel
+    {
+        #pragma omp master
+        for (long j = 0; j < reps * nb_threads; j++) {
+            #pragma omp task
+            delay(longueur_delai);
+        }
+    }
+}
+
+static void test_taskwait(long reps) {
+    #pragma omp parallel
+    for (long j = 0; j < reps; j++) {
+        #pragma omp task
+        delay(longueur_delai);
+        #pragma omp taskwait
+    }
+}
+
+// ============================================================================
+// MESURE
+// ============================================================================
+
+typedef void (*Fonction)(long reps);
+
+typedef struct {
+    const char *suite;
+    const char *nom;
+    Fonction test;
+    Fonction reference;
+    int avec_chunk;
+} Construction;
+
+static const Construction constructions[] = {
+    {"sync",  "parallel",        test_parallel,      ref_delai,     0},
+    {"sync",  "for",             test_for,           ref_delai,     0},
+    {"sync",  "parallel for",    test_parallel_for,  ref_delai,     0},
+    {"sync",  "barrier",         test_barrier,       ref_delai,     0},
+    {"sync",  "single",          test_single,        ref_delai,     0},
+    {"sync",  "critical",        test_critical,      ref_delai,     0},
+    {"sync",  "lock/unlock",     test_lock,          ref_delai,     0},
+    {"sync",  "atomic",          test_atomic,        ref_atomique,  0},
+    {"sync",  "reduction",       test_reduction,     ref_reduction, 0},
+    {"sched", "static",          test_static_bloc,   ref_boucle,    0},
+    {"sched", "static",          test_static,        ref_boucle,    1},
+    {"sched", "dynamic",         test_dynamic,       ref_boucle,    1},
+    {"sched", "guided",          test_guided,        ref_boucle,    1},
+    {"task",  "tâches (tous)",   test_taches_tous,   ref_delai,     0},
+    {"task",  "tâches (maître)", test_taches_maitre, ref_delai,     0},
+    {"task",  "task + taskwait", test_taskwait,      ref_delai,     0},
+};
+#define NB_CONSTRUCTIONS ((int)(sizeof(constructions) / sizeof(constructions[0])))
+
+static double chronometrer(Fonction f, long reps) {
+    double start = omp_get_wtime();
+    f(reps);
+    return omp_get_wtime() - start;
+}
+
+typedef struct {
+    double moyenne, ecart_type, min;   // µs
+    long innerreps;
+} Surcout;
+
+static Surcout mesurer(const Construction *c) {
+    // innerreps: multiple de nb_threads, doublé jusqu'à TEMPS_CIBLE
+    long innerreps = nb_threads;
+    while (chronometrer(c->test, innerreps) < TEMPS_CIBLE && innerreps < (1L << 30)) {
+        innerreps *= 2;
+    }
+
+    double temps_ref = 0.0;
+    for (int k = 0; k < OUTERREPS; k++) temps_ref += chronometrer(c->reference, innerreps);
+    temps_ref /= OUTERREPS;
+
+    double somme = 0.0, somme2 = 0.0, min = INFINITY;
+    for (int k = 0; k < OUTERREPS; k++) {
+        double s = (chronometrer(c->test, innerreps) - temps_ref) / innerreps * 1e6;
+        somme += s;
+        somme2 += s * s;
+        if (s < min) min = s;
+    }
+    Surcout r;
+    r.moyenne = somme / OUTERREPS;
+    r.ecart_type = sqrt(fmax(somme2 / OUTERREPS - r.moyenne * r.moyenne, 0.0));
+    r.min = min;
+    r.innerreps = innerreps;
+    return r;
+}
+
+// Itérations de delay() pour DELAI_US microsecondes
+static int calibrer_delai(void) {
+    int longueur = 1;
+    for (;;) {
+        long reps = 10000;
+        double start = omp_get_wtime();
+        for (long j = 0; j < reps; j++) delay(longueur);
+        double us = (omp_get_wtime() - start) / reps * 1e6;
+        if (us >= DELAI_US) return longueur;
+        longueur = (us > 0) ? (int)(longueur * DELAI_US / us) + 1 : longueur * 2;
+    }
+}
+
+// Largeur printf pour aligner un texte UTF-8 sur n colonnes
+static int largeur_utf8(const char *texte, int n) {
+    for (const char *c = texte; *c; c++) {
+        if ((*c & 0xC0) == 0x80) n++;
+    }
+    return n;
+}
+
+static const char *nom_compilateur(void) {
+#if defined(__clang__)
+    return "clang " __clang_version__;
+#elif defined(__GNUC__)
+    return "gcc " __VERSION__;
+#else
+    return "inconnu";
+#endif
+}
+
+// libomp (LLVM/Intel) exporte __kmpc_fork_call, même sous un binaire gcc
+static const char *nom_runtime(void) {
+    return dlsym(RTLD_DEFAULT, "__kmpc_fork_call") ? "libomp" : "libgomp";
+}
+
+int main(int argc, char *argv[]) {
+    const char *suite = "tout";
+    const char *fichier_csv = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--csv") == 0) {
+            fichier_csv = (i + 1 < argc && argv[i + 1][0] != '-') ? argv[++i] : "surcouts.csv";
+        } else {
+            suite = argv[i];
+        }
+    }
+    if (strcmp(suite, "tout") && strcmp(suite, "sync") && strcmp(suite, "sched") &&
+        strcmp(suite, "task")) {
+        fprintf(stderr, "Erreur: Suite inconnue '%s' (sync, sched, task ou tout)\n", suite);
+        return 1;
+    }
+
+    nb_threads = omp_get_max_threads();
+    omp_init_lock(&verrou);
+    longueur_delai = calibrer_delai();
+
+    FILE *csv = NULL;
+    if (fichier_csv != NULL) {
+        csv = fopen(fichier_csv, "w");
+        if (csv == NULL) {
+            fprintf(stderr, "Erreur: Impossible de créer le fichier CSV %s\n", fichier_csv);
+            return 1;
+        }
+        fprintf(csv, "suite,construction,chunk,threads,surcout_us,ecart_type_us,min_us,"
+                     "innerreps,compilateur,runtime\n");
+    }
+
+    printf("================================================================================\n");
+    printf("  SURCOÛT DES CONSTRUCTIONS OPENMP (méthode EPCC)\n");
+    printf("================================================================================\n");
+    printf("Threads: %d | Compilateur: %s | Runtime: %s\n", nb_threads,
+           nom_compilateur(), nom_runtime());
+    printf("delay(): %d itérations = %.2f µs | %d répétitions externes\n\n",
+           longueur_delai, DELAI_US, OUTERREPS);
+
+    const char *suite_courante = "";
+    int numero = 0;
+    for (int c = 0; c < NB_CONSTRUCTIONS; c++) {
+        const Construction *k = &constructions[c];
+        if (strcmp(suite, "tout") && strcmp(suite, k->suite)) continue;
+        if (strcmp(suite_courante, k->suite)) {
+            suite_courante = k->suite;
+            if (numero++) printf("\n");
+            printf("%d. %s\n", numero,
+                   !strcmp(k->suite, "sync")  ? "SYNCHRONISATION (surcoût en µs par construction)" :
+                   !strcmp(k->suite, "sched") ? "ORDONNANCEMENT (surcoût en µs par boucle)" :
+                                                "TÂCHES (surcoût en µs par tâche)");
+            printf("   %-18s %6s %12s %12s %12s\n", "Construction", "chunk", "moyenne",
+                   "écart type", "min");
+        }
+        int nb_chunks = k->avec_chunk ? 8 : 1;      // 1, 2, 4, ..., 128
+        for (int q = 0; q < nb_chunks; q++) {
+            chunk_courant = 1 << q;
+            Surcout s = mesurer(k);
+            char chunk[16];
+            snprintf(chunk, sizeof(chunk), "%d", chunk_courant);
+            printf("   %-*s %6s %12.3f %12.3f %12.3f\n", largeur_utf8(k->nom, 18), k->nom,
+                   k->avec_chunk ? chunk : "-", s.moyenne, s.ecart_type, s.min);
+            if (csv != NULL) {
+                fprintf(csv, "%s,%s,%s,%d,%.4f,%.4f,%.4f,%ld,\"%s\",%s\n", k->suite, k->nom,
+                        k->avec_chunk ? chunk : "", nb_threads, s.moyenne, s.ecart_type,
+                        s.min, s.innerreps, nom_compilateur(), nom_runtime());
+            }
+        }
+    }
+
+    if (csv != NULL) {
+        fclose(csv);
+        printf("\nFichier CSV généré: %s\n", fichier_csv);
+    }
+    omp_destroy_lock(&verrou);
+
+    printf("\n================================================================================\n");
+    printf("ANALYSE\n");
+    printf("================================================================================\n");
+    printf("- parallel et reduction: fork/join du runtime, la construction la plus chère\n");
+    printf("- for/barrier/single: une barrière (implicite) par construction\n");
+    printf("- critical/lock/atomic: surcoût par section, hors contention du délai\n");
+    printf("- dynamic/guided à petit chunk: un accès au compteur partagé par chunk\n");
+    printf("- Tâches: création + mise en file; taskwait ajoute une attente par tâche\n");
+    printf("- Surcoût négatif ou faible devant l'écart type: non mesurable ici\n");
+
+    return 0;
+}
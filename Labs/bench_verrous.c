@@ -0,0 +1,198 @@
+/*
+ * BENCHMARK: Verrous (verrous.h) vs omp critical, critical nommée, omp_lock_t
+ *
+ * Chaque thread, pendant DUREE secondes: prendre le verrou, section
+ * critique de L itérations sur des données partagées, rendre, puis un peu
+ * de travail local. On mesure:
+ *   - le débit: millions d'acquisitions par seconde (tous threads)
+ *   - l'équité: attente maximale d'un thread pour obtenir le verrou
+ *   - la correction: compteur protégé == nombre d'acquisitions
+ *
+ * 1-3. Une ressource: L = 0, 100, 1000, de 1 thread à 2x les cœurs
+ * 4. Deux ressources indépendantes: critical sans nom (une seule section
+ *    pour tout le programme) vs critical(a)/critical(b) vs deux verrous
+ *
+ * Usage: ./bench_verrous [duree_s]     (défaut: 0.1 s par mesure)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <omp.h>
+#include "verrous.h"
+
+#define NB_METHODES (VERROU_NB_TYPES + 3)
+#define M_CRITICAL VERROU_NB_TYPES
+#define M_CRITICAL_NOMME (VERROU_NB_TYPES + 1)
+#define M_OMP_LOCK (VERROU_NB_TYPES + 2)
+#define TRAVAIL_LOCAL 50
+
+static const char *nom_methode(int m) {
+    switch (m) {
+    case M_CRITICAL:       return "omp critical";
+    case M_CRITICAL_NOMME: return "critical(nommée)";
+    case M_OMP_LOCK:       return "omp_lock_t";
+    default:               return verrou_noms[m];
+    }
+}
+
+// Données protégées, sur leur propre ligne de cache
+typedef struct {
+    _Alignas(64) long compteur;
+    long donnees[7];
+} Ressource;
+
+static void section_critique(volatile Ressource *r, int longueur) {
+    r->compteur++;
+    for (int k = 0; k < longueur; k++) r->donnees[k % 7] += k;
+}
+
+static void travail_local(unsigned *graine) {
+    for (int k = 0; k < TRAVAIL_LOCAL; k++) *graine = *graine * 1103515245u + 12345u;
+}
+
+typedef struct {
+    double mops;
+    double attente_max;     // µs
+    int correct;
+} Resultat;
+
+// nb_ressources = 1 ou 2 (thread pair -> ressource 0, impair -> 1)
+static Resultat mesurer(int m, int nb_threads, int longueur, int nb_ressources, double duree) {
+    Ressource ressources[2] = {{0}, {0}};
+    Verrou verrous[2];
+    omp_lock_t locks[2];
+    for (int k = 0; k < nb_ressources; k++) {
+        if (m < VERROU_NB_TYPES) verrou_init(&verrous[k], (TypeVerrou)m, nb_threads);
+        if (m == M_OMP_LOCK) omp_init_lock(&locks[k]);
+    }
+
+    long total = 0;
+    double attente_max = 0.0;
+    double fin = omp_get_wtime() + duree;
+
+    #pragma omp parallel num_threads(nb_threads) reduction(+:total) reduction(max:attente_max)
+    {
+        int id = omp_get_thread_num();
+        int k = id % nb_ressources;
+        volatile Ressource *r = &ressources[k];
+        unsigned graine = id;
+        double maintenant = omp_get_wtime();
+
+        while (maintenant < fin) {
+            double debut = maintenant;
+            switch (m) {
+            case M_CRITICAL:
+                #pragma omp critical
+                {
+                    maintenant = omp_get_wtime();
+                    section_critique(r, longueur);
+                }
+                break;
+            case M_CRITICAL_NOMME:
+                if (k == 0) {
+                    #pragma omp critical(ressource_a)
+                    {
+                        maintenant = omp_get_wtime();
+                        section_critique(r, longueur);
+                    }
+                } else {
+                    #pragma omp critical(ressource_b)
+                    {
+                        maintenant = omp_get_wtime();
+                        section_critique(r, longueur);
+                    }
+                }
+                break;
+            case M_OMP_LOCK:
+                omp_set_lock(&locks[k]);
+                maintenant = omp_get_wtime();
+                section_critique(r, longueur);
+                omp_unset_lock(&locks[k]);
+                break;
+            default:
+                verrou_prendre(&verrous[k], id);
+                maintenant = omp_get_wtime();
+                section_critique(r, longueur);
+                verrou_rendre(&verrous[k], id);
+                break;
+            }
+            if (maintenant - debut > attente_max) attente_max = maintenant - debut;
+            total++;
+            travail_local(&graine);
+        }
+    }
+
+    Resultat res;
+    res.mops = total / duree * 1e-6;
+    res.attente_max = attente_max * 1e6;
+    res.correct = (ressources[0].compteur + ressources[1].compteur == total);
+    for (int k = 0; k < nb_ressources; k++) {
+        if (m < VERROU_NB_TYPES) verrou_liberer(&verrous[k]);
+        if (m == M_OMP_LOCK) omp_destroy_lock(&locks[k]);
+    }
+    return res;
+}
+
+int main(int argc, char *argv[]) {
+    double duree = (argc > 1) ? strtod(argv[1], NULL) : 0.1;
+    int max_threads = omp_get_max_threads() * 2;
+    int erreurs = 0;
+
+    int threads[32], nb_t = 0;
+    for (int t = 1; t <= max_threads && nb_t < 32; t *= 2) threads[nb_t++] = t;
+
+    printf("================================================================================\n");
+    printf("  VERROUS: TTAS, ticket, MCS, CLH vs omp critical et omp_lock_t\n");
+    printf("================================================================================\n");
+    printf("Cœurs: %d | Durée par mesure: %.2f s | Travail hors section: %d itérations\n\n",
+           omp_get_num_procs(), duree, TRAVAIL_LOCAL);
+
+    // ------------------------------------------------------------------------
+    int longueurs[3] = {0, 100, 1000};
+    static Resultat res[NB_METHODES][32];
+    for (int l = 0; l < 3; l++) {
+        printf("%d. SECTION CRITIQUE DE %d ITÉRATIONS\n", l + 1, longueurs[l]);
+        for (int m = 0; m < NB_METHODES; m++) {
+            for (int k = 0; k < nb_t; k++) {
+                res[m][k] = mesurer(m, threads[k], longueurs[l], 1, duree);
+                if (!res[m][k].correct) erreurs++;
+            }
+        }
+        printf("   %-17s", "M acquisitions/s");
+        for (int k = 0; k < nb_t; k++) printf(" %7d th", threads[k]);
+        printf("   | attente max (µs) à %d th\n", threads[nb_t - 1]);
+        for (int m = 0; m < NB_METHODES; m++) {
+            printf("   %-17s", nom_methode(m));
+            for (int k = 0; k < nb_t; k++) {
+                printf(" %9.2f%s", res[m][k].mops, res[m][k].correct ? " " : "✗");
+            }
+            printf("   | %10.1f\n", res[m][nb_t - 1].attente_max);
+        }
+        printf("\n");
+    }
+
+    // ------------------------------------------------------------------------
+    int t2 = (max_threads < 2) ? 2 : max_threads;
+    printf("4. DEUX RESSOURCES INDÉPENDANTES (%d threads, section de 100 itérations)\n", t2);
+    int methodes[4] = {M_CRITICAL, M_CRITICAL_NOMME, M_OMP_LOCK, VERROU_MCS};
+    for (int i = 0; i < 4; i++) {
+        Resultat r = mesurer(methodes[i], t2, 100, 2, duree);
+        if (!r.correct) erreurs++;
+        printf("   %-17s %9.2f M/s | attente max %10.1f µs %s\n",
+               nom_methode(methodes[i]), r.mops, r.attente_max, r.correct ? "✓" : "✗");
+    }
+
+    printf("\n================================================================================\n");
+    printf("ANALYSE\n");
+    printf("================================================================================\n");
+    printf("- TTAS: le plus rapide sans contention, mais un thread peut être\n");
+    printf("  doublé indéfiniment (attente max élevée)\n");
+    printf("- Ticket/MCS/CLH: FIFO, attente max bornée; MCS/CLH n'ont qu'une ligne\n");
+    printf("  transférée par passage de relais (ticket: tous relisent \"service\")\n");
+    printf("- Files FIFO + plus de threads que de cœurs: si le suivant est suspendu,\n");
+    printf("  tout le monde attend (convoi)\n");
+    printf("- critical sans nom: UNE section pour tout le programme, même pour des\n");
+    printf("  données indépendantes; critical(nom) ou un verrou par ressource\n");
+
+    return erreurs != 0;
+}
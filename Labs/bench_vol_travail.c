@@ -0,0 +1,356 @@
+/*
+ * BENCHMARK: Runtime à vol de travail (vol_travail.h) vs #pragma omp task
+ *
+ * Charges de travail comparées:
+ * 1. Latence de création de tâches: fib(n) avec une tâche par appel
+ * 2. Nombres premiers (charge irrégulière de lab3): découpage récursif
+ * 3. GEMM récursive: découpage en quadrants jusqu'à un seuil
+ *
+ * Mesures: temps, débit, taux de vol (vols / tâches créées)
+ *
+ * Conseil: OMP_WAIT_POLICY=passive évite que les threads OpenMP inactifs
+ *          consomment du CPU pendant les mesures du runtime maison.
+ *
+ * Usage: ./bench_vol_travail [nb_workers]
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <omp.h>
+#include "vol_travail.h"
+
+#define FIB_N 27
+#define PREMIERS_N 2000000
+#define PREMIERS_GRAIN 2048
+#define GEMM_N 512
+#define GEMM_SEUIL 64
+
+// ============================================================================
+// 1. FIB: une tâche par appel récursif (mesure le coût d'un spawn)
+// ============================================================================
+
+typedef struct {
+    int n;
+    long resultat;
+} ArgFib;
+
+static void fib_vt(void *p) {
+    ArgFib *a = (ArgFib*)p;
+    if (a->n < 2) {
+        a->resultat = a->n;
+        return;
+    }
+    ArgFib x = {a->n - 1, 0};
+    ArgFib y = {a->n - 2, 0};
+    VtTache t;
+    vt_spawn(&t, fib_vt, &x);
+    fib_vt(&y);
+    vt_sync(&t);
+    a->resultat = x.resultat + y.resultat;
+}
+
+static long fib_omp(int n) {
+    if (n < 2) return n;
+    long x, y;
+    #pragma omp task shared(x)
+    x = fib_omp(n - 1);
+    y = fib_omp(n - 2);
+    #pragma omp taskwait
+    return x + y;
+}
+
+// Nombre de tâches créées par fib(n): une par appel avec n >= 2
+static long nb_taches_fib(int n) {
+    long a = 0, b = 0;  // taches(0), taches(1)
+    for (int i = 2; i <= n; i++) {
+        long c = a + b + 1;
+        a = b;
+        b = c;
+    }
+    return (n == 0) ? a : b;
+}
+
+// ============================================================================
+// 2. NOMBRES PREMIERS (même test que lab3.c)
+// ============================================================================
+
+int est_premier(int n) {
+    if (n < 2) return 0;
+    if (n == 2) return 1;
+    if (n % 2 == 0) return 0;
+
+    int limite = (int)sqrt((double)n);
+    for (int i = 3; i <= limite; i += 2) {
+        if (n % i == 0) return 0;
+    }
+    return 1;
+}
+
+static long compter_intervalle(int debut, int fin) {
+    long count = 0;
+    for (int i = debut; i < fin; i++) {
+        if (est_premier(i)) count++;
+    }
+    return count;
+}
+
+typedef struct {
+    int debut, fin;
+    long count;
+} ArgPremiers;
+
+static void premiers_vt(void *p) {
+    ArgPremiers *a = (ArgPremiers*)p;
+    if (a->fin - a->debut <= PREMIERS_GRAIN) {
+        a->count = compter_intervalle(a->debut, a->fin);
+        return;
+    }
+    int milieu = a->debut + (a->fin - a->debut) / 2;
+    ArgPremiers gauche = {a->debut, milieu, 0};
+    ArgPremiers droite = {milieu, a->fin, 0};
+    VtTache t;
+    vt_spawn(&t, premiers_vt, &gauche);
+    premiers_vt(&droite);
+    vt_sync(&t);
+    a->count = gauche.count + droite.count;
+}
+
+static long premiers_omp(int debut, int fin) {
+    if (fin - debut <= PREMIERS_GRAIN) {
+        return compter_intervalle(debut, fin);
+    }
+    int milieu = debut + (fin - debut) / 2;
+    long gauche, droite;
+    #pragma omp task shared(gauche)
+    gauche = premiers_omp(debut, milieu);
+    droite = premiers_omp(milieu, fin);
+    #pragma omp taskwait
+    return gauche + droite;
+}
+
+// ============================================================================
+// 3. GEMM RÉCURSIVE: C += A * B, matrices n x n stockées par lignes (pas ld)
+// ============================================================================
+
+static void gemm_base(const double *A, const double *B, double *C, int n, int ld) {
+    for (int i = 0; i < n; i++) {
+        for (int k = 0; k < n; k++) {
+            double a = A[i * ld + k];
+            for (int j = 0; j < n; j++) {
+                C[i * ld + j] += a * B[k * ld + j];
+            }
+        }
+    }
+}
+
+typedef struct {
+    const double *A, *B;
+    double *C;
+    int n, ld;
+} ArgGemm;
+
+// Les 4 quadrants de C sont indépendants; chacun enchaîne 2 produits
+static void gemm_vt(void *p) {
+    ArgGemm *a = (ArgGemm*)p;
+    int n = a->n, ld = a->ld, h = n / 2;
+    if (n <= GEMM_SEUIL) {
+        gemm_base(a->A, a->B, a->C, n, ld);
+        return;
+    }
+    const double *A11 = a->A, *A12 = a->A + h, *A21 = a->A + h * ld, *A22 = A21 + h;
+    const double *B11 = a->B, *B12 = a->B + h, *B21 = a->B + h * ld, *B22 = B21 + h;
+    double *C11 = a->C, *C12 = a->C + h, *C21 = a->C + h * ld, *C22 = C21 + h;
+
+    ArgGemm phase1[4] = {
+        {A11, B11, C11, h, ld}, {A11, B12, C12, h, ld},
+        {A21, B11, C21, h, ld}, {A21, B12, C22, h, ld}
+    };
+    ArgGemm phase2[4] = {
+        {A12, B21, C11, h, ld}, {A12, B22, C12, h, ld},
+        {A22, B21, C21, h, ld}, {A22, B22, C22, h, ld}
+    };
+    VtTache t[3];
+    for (int q = 0; q < 3; q++) vt_spawn(&t[q], gemm_vt, &phase1[q]);
+    gemm_vt(&phase1[3]);
+    for (int q = 2; q >= 0; q--) vt_sync(&t[q]);
+    for (int q = 0; q < 3; q++) vt_spawn(&t[q], gemm_vt, &phase2[q]);
+    gemm_vt(&phase2[3]);
+    for (int q = 2; q >= 0; q--) vt_sync(&t[q]);
+}
+
+static void gemm_omp(const double *A, const double *B, double *C, int n, int ld) {
+    int h = n / 2;
+    if (n <= GEMM_SEUIL) {
+        gemm_base(A, B, C, n, ld);
+        return;
+    }
+    const double *A11 = A, *A12 = A + h, *A21 = A + h * ld, *A22 = A21 + h;
+    const double *B11 = B, *B12 = B + h, *B21 = B + h * ld, *B22 = B21 + h;
+    double *C11 = C, *C12 = C + h, *C21 = C + h * ld, *C22 = C21 + h;
+
+    #pragma omp task
+    gemm_omp(A11, B11, C11, h, ld);
+    #pragma omp task
+    gemm_omp(A11, B12, C12, h, ld);
+    #pragma omp task
+    gemm_omp(A21, B11, C21, h, ld);
+    gemm_omp(A21, B12, C22, h, ld);
+    #pragma omp taskwait
+    #pragma omp task
+    gemm_omp(A12, B21, C11, h, ld);
+    #pragma omp task
+    gemm_omp(A12, B22, C12, h, ld);
+    #pragma omp task
+    gemm_omp(A22, B21, C21, h, ld);
+    gemm_omp(A22, B22, C22, h, ld);
+    #pragma omp taskwait
+}
+
+// ============================================================================
+// AFFICHAGE
+// ============================================================================
+
+static void afficher_stats_vt(VtRuntime *rt, double temps) {
+    long spawns, vols, tentatives;
+    vt_statistiques(rt, &spawns, &vols, &tentatives);
+    printf("   Tâches: %ld | Vols réussis: %ld (%.2f%% des tâches) | "
+           "Tentatives: %ld | Vols/s: %.0f\n",
+           spawns, vols, spawns ? 100.0 * vols / spawns : 0.0,
+           tentatives, temps > 0 ? vols / temps : 0.0);
+}
+
+int main(int argc, char *argv[]) {
+    int nb_workers = (argc > 1) ? atoi(argv[1]) : 0;
+
+    printf("================================================================================\n");
+    printf("  VOL DE TRAVAIL (Chase-Lev) vs #pragma omp task\n");
+    printf("================================================================================\n");
+
+    VtRuntime *rt = vt_creer(nb_workers);
+    nb_workers = rt->nb_workers;
+    omp_set_num_threads(nb_workers);
+    printf("Workers / threads OpenMP: %d\n\n", nb_workers);
+
+    double start, temps_vt, temps_omp;
+
+    // ---------------------------------------------------------------------
+    printf("--------------------------------------------------------------------------------\n");
+    printf("1. LATENCE DE CRÉATION DE TÂCHES: fib(%d), une tâche par appel\n", FIB_N);
+    printf("--------------------------------------------------------------------------------\n");
+    long nb_taches = nb_taches_fib(FIB_N);
+
+    ArgFib arg_fib = {FIB_N, 0};
+    vt_reinitialiser_statistiques(rt);
+    start = omp_get_wtime();
+    vt_executer(rt, fib_vt, &arg_fib);
+    temps_vt = omp_get_wtime() - start;
+    printf("VOL DE TRAVAIL: fib=%ld | Temps: %.4f s | %.1f ns/tâche\n",
+           arg_fib.resultat, temps_vt, temps_vt * 1e9 / nb_taches);
+    afficher_stats_vt(rt, temps_vt);
+
+    long fib_res = 0;
+    start = omp_get_wtime();
+    #pragma omp parallel
+    #pragma omp single
+    fib_res = fib_omp(FIB_N);
+    temps_omp = omp_get_wtime() - start;
+    printf("OMP TASK:       fib=%ld | Temps: %.4f s | %.1f ns/tâche\n",
+           fib_res, temps_omp, temps_omp * 1e9 / nb_taches);
+    printf("   Ratio omp/vol: %.2fx\n\n", temps_omp / temps_vt);
+
+    // ---------------------------------------------------------------------
+    printf("--------------------------------------------------------------------------------\n");
+    printf("2. NOMBRES PREMIERS jusqu'à %d (grain %d)\n", PREMIERS_N, PREMIERS_GRAIN);
+    printf("--------------------------------------------------------------------------------\n");
+
+    ArgPremiers arg_p = {2, PREMIERS_N + 1, 0};
+    vt_reinitialiser_statistiques(rt);
+    start = omp_get_wtime();
+    vt_executer(rt, premiers_vt, &arg_p);
+    temps_vt = omp_get_wtime() - start;
+    printf("VOL DE TRAVAIL: %ld premiers | Temps: %.4f s | %.2f M nombres/s\n",
+           arg_p.count, temps_vt, PREMIERS_N / temps_vt * 1e-6);
+    afficher_stats_vt(rt, temps_vt);
+
+    long count_omp = 0;
+    start = omp_get_wtime();
+    #pragma omp parallel
+    #pragma omp single
+    count_omp = premiers_omp(2, PREMIERS_N + 1);
+    temps_omp = omp_get_wtime() - start;
+    printf("OMP TASK:       %ld premiers | Temps: %.4f s | %.2f M nombres/s\n",
+           count_omp, temps_omp, PREMIERS_N / temps_omp * 1e-6);
+
+    long count_dyn = 0;
+    start = omp_get_wtime();
+    #pragma omp parallel for schedule(dynamic, 100) reduction(+:count_dyn)
+    for (int i = 2; i <= PREMIERS_N; i++) {
+        if (est_premier(i)) count_dyn++;
+    }
+    double temps_dyn = omp_get_wtime() - start;
+    printf("OMP FOR DYNAMIC:%ld premiers | Temps: %.4f s | %.2f M nombres/s\n",
+           count_dyn, temps_dyn, PREMIERS_N / temps_dyn * 1e-6);
+    printf("   %s\n\n", (arg_p.count == count_omp && count_omp == count_dyn)
+           ? "✓ Résultats identiques" : "✗ ERREUR: résultats différents!");
+
+    // ---------------------------------------------------------------------
+    printf("--------------------------------------------------------------------------------\n");
+    printf("3. GEMM RÉCURSIVE %d x %d (seuil %d)\n", GEMM_N, GEMM_N, GEMM_SEUIL);
+    printf("--------------------------------------------------------------------------------\n");
+
+    size_t taille = (size_t)GEMM_N * GEMM_N;
+    double *A = (double*)malloc(taille * sizeof(double));
+    double *B = (double*)malloc(taille * sizeof(double));
+    double *C1 = (double*)calloc(taille, sizeof(double));
+    double *C2 = (double*)calloc(taille, sizeof(double));
+    srand(42);
+    for (size_t i = 0; i < taille; i++) {
+        A[i] = (double)(rand() % 100) / 10.0;
+        B[i] = (double)(rand() % 100) / 10.0;
+    }
+    double gflop = 2.0 * GEMM_N * GEMM_N * (double)GEMM_N * 1e-9;
+
+    ArgGemm arg_g = {A, B, C1, GEMM_N, GEMM_N};
+    vt_reinitialiser_statistiques(rt);
+    start = omp_get_wtime();
+    vt_executer(rt, gemm_vt, &arg_g);
+    temps_vt = omp_get_wtime() - start;
+    printf("VOL DE TRAVAIL: Temps: %.4f s | %.2f GFLOP/s\n", temps_vt, gflop / temps_vt);
+    afficher_stats_vt(rt, temps_vt);
+
+    start = omp_get_wtime();
+    #pragma omp parallel
+    #pragma omp single
+    gemm_omp(A, B, C2, GEMM_N, GEMM_N);
+    temps_omp = omp_get_wtime() - start;
+    printf("OMP TASK:       Temps: %.4f s | %.2f GFLOP/s\n", temps_omp, gflop / temps_omp);
+
+    int correct = 1;
+    for (size_t i = 0; i < taille; i++) {
+        if (fabs(C1[i] - C2[i]) > 1e-6) {
+            correct = 0;
+            break;
+        }
+    }
+    printf("   %s\n\n", correct ? "✓ Résultats identiques" : "✗ ERREUR: résultats différents!");
+
+    free(A);
+    free(B);
+    free(C1);
+    free(C2);
+    vt_detruire(rt);
+
+    printf("================================================================================\n");
+    printf("ANALYSE\n");
+    printf("================================================================================\n");
+    printf("- fib mesure le coût pur d'un spawn/sync: la deque Chase-Lev évite tout\n");
+    printf("  verrou sur le chemin rapide (empiler/dépiler local)\n");
+    printf("- Le taux de vol reste faible quand le découpage est récursif: chaque vol\n");
+    printf("  emporte une grosse sous-arborescence de travail\n");
+    printf("- Pour les premiers, omp for dynamic reste une référence simple et solide\n");
+
+    return 0;
+}
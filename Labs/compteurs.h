@@ -0,0 +1,130 @@
+/*
+ * COMPTEURS: Compteurs partagés sans faux partage (false sharing)
+ *
+ * Bibliothèque "header-only". compteur.c montre la course sur un compteur
+ * partagé, lab2 la corrige avec atomic/critical: correct mais chaque
+ * incrément se bat pour la même ligne de cache. Ici:
+ *
+ * 1. COMPTEUR RÉPARTI: une case par thread, chacune sur sa propre ligne
+ *    de cache (64 octets). Seul le propriétaire écrit sa case (pas
+ *    d'instruction atomique lock), la lecture additionne les cases.
+ *    Les threads d'id >= nb_cases (équipe plus grande que prévu) écrivent
+ *    tous dans une case de débordement, avec fetch_add: jamais dans la
+ *    case d'un propriétaire, dont l'écriture simple écraserait la leur.
+ *
+ *      Tableau int[8] (collapse_demo):  |c0 c1 c2 c3 c4 c5 c6 c7|  1 ligne
+ *                                        -> chaque écriture invalide la
+ *                                           ligne chez les 7 autres threads
+ *      Compteur réparti:                |c0 ......|c1 ......|...  8 lignes
+ *
+ * 2. COMPTEUR APPROXIMATIF: chaque thread accumule localement et ne publie
+ *    (atomic) qu'une fois tous les "seuil" incréments. La valeur lue a au
+ *    plus nb_threads * (seuil - 1) de retard; elle est exacte après
+ *    compteur_approx_vider par chaque thread.
+ *
+ * Utilisation:
+ *
+ *   CompteurReparti c;
+ *   compteur_reparti_init(&c, omp_get_max_threads());
+ *   #pragma omp parallel
+ *   for (...) compteur_reparti_ajouter(&c, omp_get_thread_num(), 1);
+ *   long total = compteur_reparti_lire(&c);
+ *   compteur_reparti_liberer(&c);
+ */
+
+#ifndef COMPTEURS_H
+#define COMPTEURS_H
+
+#include <stdlib.h>
+#include <stdatomic.h>
+
+#define COMPTEURS_LIGNE_CACHE 64
+
+// ============================================================================
+// 1. COMPTEUR RÉPARTI (une case alignée par thread)
+// ============================================================================
+
+typedef struct {
+    _Alignas(COMPTEURS_LIGNE_CACHE) atomic_long valeur;
+} CaseCompteur;
+
+typedef struct {
+    int nb_cases;
+    CaseCompteur *cases;         // nb_cases + 1: la dernière = débordement
+} CompteurReparti;
+
+static inline void compteur_reparti_init(CompteurReparti *c, int nb_cases) {
+    c->nb_cases = nb_cases;
+    c->cases = (CaseCompteur*)aligned_alloc(COMPTEURS_LIGNE_CACHE,
+                                            (nb_cases + 1) * sizeof(CaseCompteur));
+    for (int i = 0; i <= nb_cases; i++) {
+        atomic_init(&c->cases[i].valeur, 0);
+    }
+}
+
+static inline void compteur_reparti_liberer(CompteurReparti *c) {
+    free(c->cases);
+    c->cases = NULL;
+}
+
+// Un seul écrivain par case: lecture + écriture relaxed, sans lock.
+// id doit être unique parmi les threads qui écrivent en même temps.
+static inline void compteur_reparti_ajouter(CompteurReparti *c, int id, long delta) {
+    if (id >= 0 && id < c->nb_cases) {
+        atomic_long *v = &c->cases[id].valeur;
+        atomic_store_explicit(v, atomic_load_explicit(v, memory_order_relaxed) + delta,
+                              memory_order_relaxed);
+    } else {
+        // Plus de threads que de cases: case de débordement partagée
+        atomic_fetch_add_explicit(&c->cases[c->nb_cases].valeur, delta, memory_order_relaxed);
+    }
+}
+
+// Agrégation paresseuse: exacte quand les écrivains sont arrêtés
+static inline long compteur_reparti_lire(const CompteurReparti *c) {
+    long total = 0;
+    for (int i = 0; i <= c->nb_cases; i++) {
+        total += atomic_load_explicit(&c->cases[i].valeur, memory_order_relaxed);
+    }
+    return total;
+}
+
+// ============================================================================
+// 2. COMPTEUR APPROXIMATIF (publication par lots)
+// ============================================================================
+
+typedef struct {
+    _Alignas(COMPTEURS_LIGNE_CACHE) atomic_long global;
+    long seuil;
+} CompteurApprox;
+
+// Partie locale, à déclarer dans la région parallèle (pile du thread)
+typedef struct {
+    long en_attente;
+} CompteurApproxLocal;
+
+static inline void compteur_approx_init(CompteurApprox *c, long seuil) {
+    atomic_init(&c->global, 0);
+    c->seuil = seuil;
+}
+
+static inline void compteur_approx_ajouter(CompteurApprox *c, CompteurApproxLocal *l, long delta) {
+    l->en_attente += delta;
+    if (l->en_attente >= c->seuil) {
+        atomic_fetch_add_explicit(&c->global, l->en_attente, memory_order_relaxed);
+        l->en_attente = 0;
+    }
+}
+
+static inline void compteur_approx_vider(CompteurApprox *c, CompteurApproxLocal *l) {
+    if (l->en_attente != 0) {
+        atomic_fetch_add_explicit(&c->global, l->en_attente, memory_order_relaxed);
+        l->en_attente = 0;
+    }
+}
+
+static inline long compteur_approx_lire(const CompteurApprox *c) {
+    return atomic_load_explicit(&c->global, memory_order_relaxed);
+}
+
+#endif
@@ -0,0 +1,421 @@
+/*
+ * CRIBLE: Crible d'Ératosthène segmenté et parallèle
+ *
+ * Bibliothèque "header-only" utilisée par lab3.c et les programmes associés.
+ *
+ * Principe:
+ * - Les premiers de base (jusqu'à sqrt(N)) sont calculés une seule fois
+ * - L'intervalle [0, N] est découpé en segments qui tiennent dans le cache L1
+ * - Chaque thread prend le segment suivant dynamiquement (schedule dynamic, 1)
+ * - Un segment ne stocke que les impairs: 1 bit par nombre impair
+ * - Le comptage se fait avec popcount sur des mots de 64 bits
+ *
+ * Convention: dans un segment [lo, hi) avec lo pair, le bit j représente
+ * le nombre impair lo + 2j + 1. Bit à 1 = premier.
+ *
+ * Représentations comparées (octets par nombre couvert):
+ * - Octets (1 octet par nombre)        : 1       -> count_primes_crible_octets
+ * - Impairs (1 bit par impair)         : 1/16    -> count_primes_crible_segmente
+ * - Roue mod 30 (8 bits pour 30 nombres): 1/30    -> count_primes_crible_roue
+ */
+
+#ifndef CRIBLE_H
+#define CRIBLE_H
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include <omp.h>
+
+// Taille d'un segment en octets (32 Ko = cache L1 typique)
+#ifndef CRIBLE_SEGMENT_OCTETS
+#define CRIBLE_SEGMENT_OCTETS (32 * 1024)
+#endif
+
+// Nombres couverts par un segment: 8 bits par octet, 2 nombres par bit
+#define CRIBLE_SEGMENT_NOMBRES ((uint64_t)CRIBLE_SEGMENT_OCTETS * 16)
+
+// Racine carrée entière exacte (sqrt en double peut se tromper d'une unité)
+static inline uint64_t crible_isqrt(uint64_t n) {
+    uint64_t r = (uint64_t)sqrt((double)n);
+    while (r * r > n) r--;
+    while ((r + 1) * (r + 1) <= n) r++;
+    return r;
+}
+
+// Premiers impairs <= limite (crible simple, limite ~ sqrt(N) donc petit)
+static inline uint32_t *crible_premiers_base(uint32_t limite, size_t *nb) {
+    *nb = 0;
+    if (limite < 3) return (uint32_t*)malloc(sizeof(uint32_t));
+
+    uint8_t *compose = (uint8_t*)calloc(limite + 1, 1);
+    for (uint32_t i = 3; (uint64_t)i * i <= limite; i += 2) {
+        if (!compose[i]) {
+            for (uint32_t j = i * i; j <= limite; j += 2 * i) {
+                compose[j] = 1;
+            }
+        }
+    }
+
+    // Borne supérieure de pi(limite) pour l'allocation
+    size_t capacite = (size_t)(1.26 * limite / log((double)limite)) + 8;
+    uint32_t *premiers = (uint32_t*)malloc(capacite * sizeof(uint32_t));
+    for (uint32_t i = 3; i <= limite; i += 2) {
+        if (!compose[i]) premiers[(*nb)++] = i;
+    }
+    free(compose);
+    return premiers;
+}
+
+// Nombre de bits d'un segment [lo, hi), lo pair
+static inline size_t crible_nb_bits(uint64_t lo, uint64_t hi) {
+    return (size_t)((hi - lo) / 2);
+}
+
+// Crible les impairs de [lo, hi) (lo pair) dans bits; bit à 1 = premier
+static inline void crible_segment_impairs(const uint32_t *base, size_t nb_base,
+                                          uint64_t lo, uint64_t hi, uint64_t *bits) {
+    size_t nb_bits = crible_nb_bits(lo, hi);
+    size_t nb_mots = (nb_bits + 63) / 64;
+    memset(bits, 0xFF, nb_mots * sizeof(uint64_t));
+    if (nb_bits % 64) {
+        bits[nb_mots - 1] = (1ull << (nb_bits % 64)) - 1;
+    }
+    if (lo == 0 && nb_bits > 0) {
+        bits[0] &= ~1ull;  // 1 n'est pas premier
+    }
+
+    for (size_t k = 0; k < nb_base; k++) {
+        uint64_t p = base[k];
+        uint64_t carre = p * p;
+        if (carre >= hi) break;
+
+        // Premier multiple impair de p >= max(p², lo + 1)
+        uint64_t debut = carre;
+        if (debut < lo + 1) {
+            debut = (lo + 1 + p - 1) / p * p;
+            if (debut % 2 == 0) debut += p;
+        }
+        for (uint64_t j = (debut - lo - 1) / 2; j < nb_bits; j += p) {
+            bits[j >> 6] &= ~(1ull << (j & 63));
+        }
+    }
+}
+
+static inline uint64_t crible_compter_bits(const uint64_t *bits, size_t nb_bits) {
+    uint64_t count = 0;
+    size_t nb_mots = (nb_bits + 63) / 64;
+    for (size_t i = 0; i < nb_mots; i++) {
+        count += (uint64_t)__builtin_popcountll(bits[i]);
+    }
+    return count;
+}
+
+// Nombre de segments de count_primes_crible_segmente pour [0, n]
+static inline uint64_t crible_nb_segments(uint64_t n) {
+    return (n + 1 + CRIBLE_SEGMENT_NOMBRES - 1) / CRIBLE_SEGMENT_NOMBRES;
+}
+
+// Nombre de premiers <= n avec le crible segmenté parallèle; avancer
+// (optionnel, NULL sinon) est appelé après chaque segment avec le numéro
+// du thread, cf. progression_rappel
+static inline uint64_t count_primes_crible_segmente_suivi(uint64_t n, int num_threads,
+                                                          void (*avancer)(void*, int, long),
+                                                          void *arg) {
+    if (n < 2) return 0;
+
+    size_t nb_base;
+    uint32_t *base = crible_premiers_base((uint32_t)crible_isqrt(n), &nb_base);
+
+    uint64_t fin = n + 1;  // Intervalle [0, n] = [0, fin)
+    uint64_t nb_segments = crible_nb_segments(n);
+    uint64_t count = 1;    // Le nombre 2
+
+    #pragma omp parallel num_threads(num_threads) reduction(+:count)
+    {
+        uint64_t *bits = (uint64_t*)malloc(CRIBLE_SEGMENT_OCTETS);
+        int id = omp_get_thread_num();
+
+        #pragma omp for schedule(dynamic, 1)
+        for (uint64_t s = 0; s < nb_segments; s++) {
+            uint64_t lo = s * CRIBLE_SEGMENT_NOMBRES;
+            uint64_t hi = (lo + CRIBLE_SEGMENT_NOMBRES < fin) ? lo + CRIBLE_SEGMENT_NOMBRES : fin;
+            crible_segment_impairs(base, nb_base, lo, hi, bits);
+            count += crible_compter_bits(bits, crible_nb_bits(lo, hi));
+            if (avancer != NULL) avancer(arg, id, 1);
+        }
+
+        free(bits);
+    }
+
+    free(base);
+    return count;
+}
+
+static inline uint64_t count_primes_crible_segmente(uint64_t n, int num_threads) {
+    return count_primes_crible_segmente_suivi(n, num_threads, NULL, NULL);
+}
+
+// ============================================================================
+// RÉFÉRENCE: 1 OCTET PAR NOMBRE (pour mesurer la bande passante économisée)
+// ============================================================================
+
+// Octet i du segment = nombre lo + i; seuls les impairs sont utilisés
+static inline void crible_segment_octets(const uint32_t *base, size_t nb_base,
+                                         uint64_t lo, uint64_t hi, uint8_t *octets) {
+    memset(octets, 1, hi - lo);
+    if (lo == 0) {
+        octets[1] = 0;  // 1 n'est pas premier
+    }
+    for (size_t k = 0; k < nb_base; k++) {
+        uint64_t p = base[k];
+        uint64_t carre = p * p;
+        if (carre >= hi) break;
+        uint64_t debut = carre;
+        if (debut < lo) {
+            debut = (lo + p - 1) / p * p;
+            if (debut % 2 == 0) debut += p;
+        }
+        for (uint64_t m = debut; m < hi; m += 2 * p) {
+            octets[m - lo] = 0;
+        }
+    }
+}
+
+static inline uint64_t count_primes_crible_octets(uint64_t n, int num_threads) {
+    if (n < 2) return 0;
+
+    size_t nb_base;
+    uint32_t *base = crible_premiers_base((uint32_t)crible_isqrt(n), &nb_base);
+
+    uint64_t fin = n + 1;
+    uint64_t nb_segments = (fin + CRIBLE_SEGMENT_OCTETS - 1) / CRIBLE_SEGMENT_OCTETS;
+    uint64_t count = 1;    // Le nombre 2
+
+    #pragma omp parallel num_threads(num_threads) reduction(+:count)
+    {
+        uint8_t *octets = (uint8_t*)malloc(CRIBLE_SEGMENT_OCTETS);
+
+        #pragma omp for schedule(dynamic, 1)
+        for (uint64_t s = 0; s < nb_segments; s++) {
+            uint64_t lo = s * CRIBLE_SEGMENT_OCTETS;
+            uint64_t hi = (lo + CRIBLE_SEGMENT_OCTETS < fin) ? lo + CRIBLE_SEGMENT_OCTETS : fin;
+            crible_segment_octets(base, nb_base, lo, hi, octets);
+            for (uint64_t i = 1; i < hi - lo; i += 2) {
+                count += octets[i];
+            }
+        }
+
+        free(octets);
+    }
+
+    free(base);
+    return count;
+}
+
+// ============================================================================
+// ROUE MODULO 30: seuls les résidus premiers avec 30 sont stockés
+// ============================================================================
+//
+// L'octet k couvre [30k, 30k + 30); son bit i représente 30k + ROUE_RESIDUS[i].
+// Pour un premier p = 30q + r et un multiplicateur m = 30a + R[j] (premier
+// avec 30), le multiple p*m tombe dans l'octet p*a + q*R[j] + (r*R[j])/30,
+// au bit de (r*R[j]) mod 30. Ces 8 décalages et 8 masques sont précalculés
+// par premier: le crible avance ensuite de p octets par tour de roue.
+
+static const uint8_t ROUE_RESIDUS[8] = {1, 7, 11, 13, 17, 19, 23, 29};
+
+// Index du bit pour un résidu mod 30 (-1 si non premier avec 30)
+static const int8_t ROUE_INDEX[30] = {
+    -1, 0, -1, -1, -1, -1, -1, 1, -1, -1, -1, 2, -1, 3, -1,
+    -1, -1, 4, -1, 5, -1, -1, -1, 6, -1, -1, -1, -1, -1, 7
+};
+
+// Pré-criblage: motif des multiples de 7, 11, 13, 17 (période 7*11*13*17 octets)
+#define ROUE_PRECRIBLE_MAX 17
+#define ROUE_MOTIF_OCTETS (7 * 11 * 13 * 17)
+
+typedef struct {
+    uint32_t p;
+    uint32_t decalage[8];   // Octet du multiple p*(30a + R[j]), moins p*a
+    uint8_t masque[8];      // Bit à effacer dans cet octet
+} PremierRoue;
+
+typedef struct {
+    PremierRoue *premiers;  // Premiers de base > ROUE_PRECRIBLE_MAX
+    size_t nb;
+    uint8_t *motif;         // ROUE_MOTIF_OCTETS octets pré-criblés
+} CribleRoue;
+
+static inline void crible_roue_preparer(PremierRoue *pr, uint32_t p) {
+    uint32_t q = p / 30, r = p % 30;
+    pr->p = p;
+    for (int j = 0; j < 8; j++) {
+        uint32_t produit = r * ROUE_RESIDUS[j];
+        pr->decalage[j] = q * ROUE_RESIDUS[j] + produit / 30;
+        pr->masque[j] = (uint8_t)(1u << ROUE_INDEX[produit % 30]);
+    }
+}
+
+// Prépare la roue pour cribler jusqu'à n
+static inline void crible_roue_init(CribleRoue *roue, uint64_t n) {
+    size_t nb_base;
+    uint32_t *base = crible_premiers_base((uint32_t)crible_isqrt(n), &nb_base);
+
+    roue->premiers = (PremierRoue*)malloc((nb_base + 1) * sizeof(PremierRoue));
+    roue->nb = 0;
+    for (size_t k = 0; k < nb_base; k++) {
+        if (base[k] > ROUE_PRECRIBLE_MAX) {
+            crible_roue_preparer(&roue->premiers[roue->nb++], base[k]);
+        }
+    }
+    free(base);
+
+    // Motif répétitif: un tour complet de chaque petit premier tient dans la période
+    roue->motif = (uint8_t*)malloc(ROUE_MOTIF_OCTETS);
+    memset(roue->motif, 0xFF, ROUE_MOTIF_OCTETS);
+    const uint32_t petits[4] = {7, 11, 13, 17};
+    for (int k = 0; k < 4; k++) {
+        PremierRoue pr;
+        crible_roue_preparer(&pr, petits[k]);
+        for (uint32_t a = 0; a < ROUE_MOTIF_OCTETS / petits[k]; a++) {
+            for (int j = 0; j < 8; j++) {
+                roue->motif[petits[k] * a + pr.decalage[j]] &= (uint8_t)~pr.masque[j];
+            }
+        }
+    }
+}
+
+static inline void crible_roue_liberer(CribleRoue *roue) {
+    free(roue->premiers);
+    free(roue->motif);
+}
+
+// Crible les octets [octet_lo, octet_lo + nb_octets) de la roue dans seg
+static inline void crible_segment_roue(const CribleRoue *roue, uint64_t octet_lo,
+                                       size_t nb_octets, uint8_t *seg) {
+    // 1. Pré-criblage par copie du motif répétitif
+    size_t pos = (size_t)(octet_lo % ROUE_MOTIF_OCTETS);
+    size_t fait = 0;
+    while (fait < nb_octets) {
+        size_t morceau = ROUE_MOTIF_OCTETS - pos;
+        if (morceau > nb_octets - fait) morceau = nb_octets - fait;
+        memcpy(seg + fait, roue->motif + pos, morceau);
+        fait += morceau;
+        pos = 0;
+    }
+    if (octet_lo == 0) {
+        // 1 n'est pas premier; 7, 11, 13 et 17 le sont (effacés par le motif)
+        seg[0] = (uint8_t)((seg[0] & ~1u) | 0x1E);
+    }
+
+    // 2. Crible par les premiers de base, tour de roue par tour de roue
+    uint64_t nombre_lo = octet_lo * 30;
+    uint64_t nombre_hi = (octet_lo + nb_octets) * 30;
+    for (size_t k = 0; k < roue->nb; k++) {
+        const PremierRoue *pr = &roue->premiers[k];
+        uint64_t p = pr->p;
+        if (p * p >= nombre_hi) break;
+
+        // Plus petit multiplicateur m >= p (départ à p²) avec p*m >= nombre_lo
+        uint64_t m = (nombre_lo + p - 1) / p;
+        if (m < p) m = p;
+        uint64_t a = m / 30;
+        int j = 0;
+        while (j < 8 && 30 * a + ROUE_RESIDUS[j] < m) j++;
+        if (j == 8) {
+            a++;
+            j = 0;
+        }
+
+        int64_t base = (int64_t)(p * a) - (int64_t)octet_lo;
+        // Premier tour (partiel)
+        for (; j < 8; j++) {
+            int64_t idx = base + pr->decalage[j];
+            if (idx >= (int64_t)nb_octets) goto prochain_premier;
+            seg[idx] &= (uint8_t)~pr->masque[j];
+        }
+        base += (int64_t)p;
+        // Tours complets: les 8 décalages sont < p, aucun test de borne
+        while (base + (int64_t)p <= (int64_t)nb_octets) {
+            uint8_t *o = seg + base;
+            o[pr->decalage[0]] &= (uint8_t)~pr->masque[0];
+            o[pr->decalage[1]] &= (uint8_t)~pr->masque[1];
+            o[pr->decalage[2]] &= (uint8_t)~pr->masque[2];
+            o[pr->decalage[3]] &= (uint8_t)~pr->masque[3];
+            o[pr->decalage[4]] &= (uint8_t)~pr->masque[4];
+            o[pr->decalage[5]] &= (uint8_t)~pr->masque[5];
+            o[pr->decalage[6]] &= (uint8_t)~pr->masque[6];
+            o[pr->decalage[7]] &= (uint8_t)~pr->masque[7];
+            base += (int64_t)p;
+        }
+        // Dernier tour (partiel)
+        for (j = 0; j < 8; j++) {
+            int64_t idx = base + pr->decalage[j];
+            if (idx >= (int64_t)nb_octets) break;
+            seg[idx] &= (uint8_t)~pr->masque[j];
+        }
+    prochain_premier:;
+    }
+}
+
+// Efface les bits des nombres > n dans l'octet de la roue qui contient n
+static inline uint8_t crible_roue_masque_fin(uint64_t n) {
+    uint8_t masque = 0;
+    for (int i = 0; i < 8; i++) {
+        if ((n / 30) * 30 + ROUE_RESIDUS[i] <= n) masque |= (uint8_t)(1u << i);
+    }
+    return masque;
+}
+
+static inline uint64_t crible_compter_octets_roue(const uint8_t *seg, size_t nb_octets) {
+    uint64_t count = 0;
+    size_t i = 0;
+    for (; i + 8 <= nb_octets; i += 8) {
+        uint64_t mot;
+        memcpy(&mot, seg + i, 8);
+        count += (uint64_t)__builtin_popcountll(mot);
+    }
+    for (; i < nb_octets; i++) {
+        count += (uint64_t)__builtin_popcount(seg[i]);
+    }
+    return count;
+}
+
+// Nombre de premiers <= n avec la roue mod 30 segmentée
+static inline uint64_t count_primes_crible_roue(uint64_t n, int num_threads) {
+    if (n < 2) return 0;
+    uint64_t count = (n >= 5) ? 3 : (n >= 3) ? 2 : 1;  // 2, 3, 5
+
+    CribleRoue roue;
+    crible_roue_init(&roue, n);
+
+    uint64_t nb_octets_total = n / 30 + 1;
+    uint64_t nb_segments = (nb_octets_total + CRIBLE_SEGMENT_OCTETS - 1) / CRIBLE_SEGMENT_OCTETS;
+    uint8_t masque_fin = crible_roue_masque_fin(n);
+
+    #pragma omp parallel num_threads(num_threads) reduction(+:count)
+    {
+        uint8_t *seg = (uint8_t*)malloc(CRIBLE_SEGMENT_OCTETS);
+
+        #pragma omp for schedule(dynamic, 1)
+        for (uint64_t s = 0; s < nb_segments; s++) {
+            uint64_t octet_lo = s * CRIBLE_SEGMENT_OCTETS;
+            size_t nb_octets = (size_t)((octet_lo + CRIBLE_SEGMENT_OCTETS < nb_octets_total)
+                             ? CRIBLE_SEGMENT_OCTETS : nb_octets_total - octet_lo);
+            crible_segment_roue(&roue, octet_lo, nb_octets, seg);
+            if (s == nb_segments - 1) {
+                seg[nb_octets - 1] &= masque_fin;
+            }
+            count += crible_compter_octets_roue(seg, nb_octets);
+        }
+
+        free(seg);
+    }
+
+    crible_roue_liberer(&roue);
+    return count;
+}
+
+#endif
@@ -0,0 +1,382 @@
+/*
+ * CRIBLE INCRÉMENTAL: étendre la limite sans tout recalculer
+ *
+ * L'état du crible après avoir traité [0, fin) tient en peu de place:
+ * - fin et le nombre de premiers impairs trouvés
+ * - les premiers de base (jusqu'à sqrt(fin))
+ * - pour chaque premier de base, son prochain multiple impair >= fin
+ *
+ * Cet état est sauvegardé sur disque (point de reprise). Pour passer de N
+ * à N' > N, on ne crible que [fin, N'] en parallèle:
+ * - les nouveaux premiers de base (sqrt(N) < p <= sqrt(N')) commencent à p²
+ * - la nouvelle plage est découpée en une tranche contiguë par thread
+ * - chaque thread avance une copie des prochains multiples jusqu'au début
+ *   de sa tranche (une division par premier), puis les fait glisser de
+ *   segment en segment sans aucune division
+ * - les prochains multiples de la dernière tranche deviennent le nouvel état
+ *
+ * Un calcul complet n'est qu'une extension depuis l'état vide: les deux
+ * chemins du benchmark utilisent donc exactement le même code.
+ *
+ * Usage:
+ *   ./crible_incremental                        # Démo: 1e9 -> 2e9 vs recalcul complet
+ *   ./crible_incremental etendre N [fichier]    # Reprend le point de reprise et l'étend
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <stdint.h>
+#include <omp.h>
+#include "crible.h"
+
+#define ETAT_MAGIQUE "CRIBINC1"
+#define ETAT_FICHIER_DEFAUT "crible.etat"
+
+typedef struct {
+    uint64_t fin;         // Intervalle traité: [0, fin), fin pair
+    uint64_t count;       // Premiers impairs dans [0, fin)
+    uint32_t racine;      // Premiers de base connus jusqu'à racine
+    size_t nb_base;
+    uint32_t *base;       // Premiers impairs <= racine
+    uint64_t *prochain;   // Prochain multiple impair de base[k] >= fin
+} EtatCrible;
+
+typedef struct {
+    char magique[8];
+    uint64_t fin;
+    uint64_t count;
+    uint64_t racine;
+    uint64_t nb_base;
+} EnteteEtat;
+
+static void etat_init(EtatCrible *etat) {
+    etat->fin = 0;
+    etat->count = 0;
+    etat->racine = 0;
+    etat->nb_base = 0;
+    etat->base = NULL;
+    etat->prochain = NULL;
+}
+
+static void etat_liberer(EtatCrible *etat) {
+    free(etat->base);
+    free(etat->prochain);
+    etat_init(etat);
+}
+
+// Nombre de premiers <= n, n étant la limite de la dernière extension
+static uint64_t etat_pi(const EtatCrible *etat, uint64_t n) {
+    return (n >= 2) ? etat->count + 1 : 0;
+}
+
+// ============================================================================
+// POINT DE REPRISE
+// ============================================================================
+
+static int etat_sauver(const EtatCrible *etat, const char *chemin) {
+    FILE *f = fopen(chemin, "wb");
+    if (!f) {
+        fprintf(stderr, "Erreur: Impossible de créer %s\n", chemin);
+        return -1;
+    }
+    EnteteEtat entete;
+    memcpy(entete.magique, ETAT_MAGIQUE, 8);
+    entete.fin = etat->fin;
+    entete.count = etat->count;
+    entete.racine = etat->racine;
+    entete.nb_base = etat->nb_base;
+
+    int ok = fwrite(&entete, sizeof(entete), 1, f) == 1 &&
+             fwrite(etat->base, sizeof(uint32_t), etat->nb_base, f) == etat->nb_base &&
+             fwrite(etat->prochain, sizeof(uint64_t), etat->nb_base, f) == etat->nb_base;
+    fclose(f);
+    if (!ok) {
+        fprintf(stderr, "Erreur: Écriture de %s incomplète\n", chemin);
+        return -1;
+    }
+    return 0;
+}
+
+// 0: état chargé, 1: fichier absent (état inchangé), -1: erreur
+static int etat_charger(EtatCrible *etat, const char *chemin) {
+    FILE *f = fopen(chemin, "rb");
+    if (!f) {
+        if (errno == ENOENT) return 1;
+        fprintf(stderr, "Erreur: Impossible d'ouvrir %s\n", chemin);
+        return -1;
+    }
+
+    EnteteEtat entete;
+    if (fread(&entete, sizeof(entete), 1, f) != 1 ||
+        memcmp(entete.magique, ETAT_MAGIQUE, 8) != 0) {
+        fprintf(stderr, "Erreur: %s n'est pas un point de reprise valide\n", chemin);
+        fclose(f);
+        return -1;
+    }
+    etat->fin = entete.fin;
+    etat->count = entete.count;
+    etat->racine = (uint32_t)entete.racine;
+    etat->nb_base = (size_t)entete.nb_base;
+    etat->base = (uint32_t*)malloc((etat->nb_base + 1) * sizeof(uint32_t));
+    etat->prochain = (uint64_t*)malloc((etat->nb_base + 1) * sizeof(uint64_t));
+    if (etat->base == NULL || etat->prochain == NULL) {
+        fprintf(stderr, "Erreur: %s annonce %zu premiers de base, mémoire insuffisante\n",
+                chemin, etat->nb_base);
+        fclose(f);
+        etat_liberer(etat);
+        return -1;
+    }
+
+    int ok = fread(etat->base, sizeof(uint32_t), etat->nb_base, f) == etat->nb_base &&
+             fread(etat->prochain, sizeof(uint64_t), etat->nb_base, f) == etat->nb_base;
+    fclose(f);
+    if (!ok) {
+        fprintf(stderr, "Erreur: %s est tronqué\n", chemin);
+        etat_liberer(etat);
+        return -1;
+    }
+    return 0;
+}
+
+// ============================================================================
+// EXTENSION
+// ============================================================================
+
+// Crible [lo, hi) (lo pair) avec les prochains multiples, puis les avance à hi
+static uint64_t crible_segment_reprise(const uint32_t *base, uint64_t *prochain, size_t nb_base,
+                                       uint64_t lo, uint64_t hi, uint64_t *bits) {
+    size_t nb_bits = crible_nb_bits(lo, hi);
+    size_t nb_mots = (nb_bits + 63) / 64;
+    memset(bits, 0xFF, nb_mots * sizeof(uint64_t));
+    if (nb_bits % 64) {
+        bits[nb_mots - 1] = (1ull << (nb_bits % 64)) - 1;
+    }
+    if (lo == 0 && nb_bits > 0) {
+        bits[0] &= ~1ull;  // 1 n'est pas premier
+    }
+
+    for (size_t k = 0; k < nb_base; k++) {
+        uint64_t p = base[k];
+        if (prochain[k] >= hi) {
+            if (p * p >= hi) break;  // Premiers suivants pas encore actifs
+            continue;
+        }
+        uint64_t j = (prochain[k] - lo - 1) / 2;
+        for (; j < nb_bits; j += p) {
+            bits[j >> 6] &= ~(1ull << (j & 63));
+        }
+        prochain[k] = lo + 2 * j + 1;
+    }
+    return crible_compter_bits(bits, nb_bits);
+}
+
+// Étend l'état jusqu'à n inclus (n >= fin), en parallèle sur num_threads
+static void etat_etendre(EtatCrible *etat, uint64_t n, int num_threads) {
+    uint64_t nouvelle_fin = (n + 1) & ~1ull;  // n pair > 2 n'est jamais premier
+    if (nouvelle_fin <= etat->fin) return;
+
+    // 1. Nouveaux premiers de base: ils commencent à p² (> ancienne fin)
+    uint32_t racine = (uint32_t)crible_isqrt(nouvelle_fin);
+    if (racine > etat->racine) {
+        size_t nb;
+        uint32_t *base = crible_premiers_base(racine, &nb);
+        uint64_t *prochain = (uint64_t*)malloc((nb + 1) * sizeof(uint64_t));
+        if (etat->nb_base > 0) {
+            memcpy(prochain, etat->prochain, etat->nb_base * sizeof(uint64_t));
+        }
+        for (size_t k = etat->nb_base; k < nb; k++) {
+            prochain[k] = (uint64_t)base[k] * base[k];
+        }
+        free(etat->base);
+        free(etat->prochain);
+        etat->base = base;
+        etat->prochain = prochain;
+        etat->nb_base = nb;
+        etat->racine = racine;
+    }
+
+    // 2. Une tranche contiguë par thread, alignée sur les segments
+    uint64_t debut = etat->fin;
+    uint64_t nb_segments = (nouvelle_fin - debut + CRIBLE_SEGMENT_NOMBRES - 1) / CRIBLE_SEGMENT_NOMBRES;
+    int nb_tranches = (nb_segments < (uint64_t)num_threads) ? (int)nb_segments : num_threads;
+    uint64_t count = 0;
+
+    #pragma omp parallel num_threads(nb_tranches) reduction(+:count)
+    {
+        int t = omp_get_thread_num();
+        int nb = omp_get_num_threads();
+        uint64_t seg_debut = nb_segments * t / nb;
+        uint64_t seg_fin = nb_segments * (t + 1) / nb;
+        uint64_t lo_tranche = debut + seg_debut * CRIBLE_SEGMENT_NOMBRES;
+
+        // Copie locale des prochains multiples, avancée au début de la tranche
+        uint64_t *prochain = (uint64_t*)malloc((etat->nb_base + 1) * sizeof(uint64_t));
+        for (size_t k = 0; k < etat->nb_base; k++) {
+            uint64_t m = etat->prochain[k];
+            if (m < lo_tranche) {
+                uint64_t pas = 2 * (uint64_t)etat->base[k];
+                m += (lo_tranche - m + pas - 1) / pas * pas;
+            }
+            prochain[k] = m;
+        }
+
+        uint64_t *bits = (uint64_t*)malloc(CRIBLE_SEGMENT_OCTETS);
+        for (uint64_t s = seg_debut; s < seg_fin; s++) {
+            uint64_t lo = debut + s * CRIBLE_SEGMENT_NOMBRES;
+            uint64_t hi = (lo + CRIBLE_SEGMENT_NOMBRES < nouvelle_fin) ? lo + CRIBLE_SEGMENT_NOMBRES : nouvelle_fin;
+            count += crible_segment_reprise(etat->base, prochain, etat->nb_base, lo, hi, bits);
+        }
+        free(bits);
+
+        // La dernière tranche s'arrête à nouvelle_fin: ses multiples sont le nouvel état
+        #pragma omp barrier
+        if (t == nb - 1) {
+            memcpy(etat->prochain, prochain, etat->nb_base * sizeof(uint64_t));
+        }
+        free(prochain);
+    }
+
+    etat->count += count;
+    etat->fin = nouvelle_fin;
+}
+
+// ============================================================================
+// BENCHMARK
+// ============================================================================
+
+static double calcul_complet(uint64_t n, int num_threads, uint64_t *pi) {
+    EtatCrible etat;
+    etat_init(&etat);
+    double start = omp_get_wtime();
+    etat_etendre(&etat, n, num_threads);
+    double temps = omp_get_wtime() - start;
+    *pi = etat_pi(&etat, n);
+    etat_liberer(&etat);
+    return temps;
+}
+
+static int demo(uint64_t n1, uint64_t n2, const char *chemin) {
+    int num_threads = omp_get_max_threads();
+    int erreurs = 0;
+
+    printf("1. CALCUL INITIAL ET POINT DE REPRISE\n");
+    EtatCrible etat;
+    etat_init(&etat);
+    double start = omp_get_wtime();
+    etat_etendre(&etat, n1, num_threads);
+    double temps_initial = omp_get_wtime() - start;
+
+    start = omp_get_wtime();
+    if (etat_sauver(&etat, chemin) != 0) return 1;
+    double temps_sauvegarde = omp_get_wtime() - start;
+    size_t octets = sizeof(EnteteEtat) + etat.nb_base * (sizeof(uint32_t) + sizeof(uint64_t));
+    printf("   pi(%llu) = %llu | Temps: %.4f s\n", (unsigned long long)n1,
+           (unsigned long long)etat_pi(&etat, n1), temps_initial);
+    printf("   Point de reprise %s: %zu premiers de base, %.1f Ko, écrit en %.4f s\n\n",
+           chemin, etat.nb_base, octets / 1024.0, temps_sauvegarde);
+    etat_liberer(&etat);
+
+    printf("2. EXTENSION %llu -> %llu DEPUIS LE DISQUE\n", (unsigned long long)n1,
+           (unsigned long long)n2);
+    start = omp_get_wtime();
+    if (etat_charger(&etat, chemin) != 0) return 1;
+    double temps_chargement = omp_get_wtime() - start;
+    start = omp_get_wtime();
+    etat_etendre(&etat, n2, num_threads);
+    double temps_extension = omp_get_wtime() - start;
+    uint64_t pi_incremental = etat_pi(&etat, n2);
+    printf("   Chargement: %.4f s | Extension: %.4f s | pi(%llu) = %llu\n\n",
+           temps_chargement, temps_extension, (unsigned long long)n2,
+           (unsigned long long)pi_incremental);
+    etat_liberer(&etat);
+
+    printf("3. RECALCUL COMPLET DE pi(%llu)\n", (unsigned long long)n2);
+    uint64_t pi_complet;
+    double temps_complet = calcul_complet(n2, num_threads, &pi_complet);
+    uint64_t pi_reference = count_primes_crible_segmente(n2, num_threads);
+    printf("   Temps: %.4f s | pi(%llu) = %llu (crible.h: %llu) %s\n",
+           temps_complet, (unsigned long long)n2, (unsigned long long)pi_complet,
+           (unsigned long long)pi_reference,
+           (pi_complet == pi_reference && pi_incremental == pi_reference) ? "✓" : "✗");
+    if (pi_complet != pi_reference || pi_incremental != pi_reference) erreurs++;
+    printf("   Gain de l'extension: %.2fx (%.0f%% du temps évité)\n\n",
+           temps_complet / (temps_chargement + temps_extension),
+           100.0 * (1.0 - (temps_chargement + temps_extension) / temps_complet));
+
+    printf("4. EXTENSIONS SUCCESSIVES (pas de %llu) vs RECALCULS\n", (unsigned long long)((n2 - n1) / 4));
+    printf("   %-14s %14s %14s %14s %10s\n", "Limite", "pi", "Extension (s)", "Complet (s)", "Gain");
+    etat_init(&etat);
+    etat_etendre(&etat, n1, num_threads);
+    for (int i = 1; i <= 4; i++) {
+        uint64_t n = n1 + (n2 - n1) / 4 * i;
+        start = omp_get_wtime();
+        etat_etendre(&etat, n, num_threads);
+        double temps_ext = omp_get_wtime() - start;
+        uint64_t pi_c;
+        double temps_c = calcul_complet(n, num_threads, &pi_c);
+        if (pi_c != etat_pi(&etat, n)) erreurs++;
+        printf("   %-14llu %14llu %14.4f %14.4f %9.2fx %s\n", (unsigned long long)n,
+               (unsigned long long)etat_pi(&etat, n), temps_ext, temps_c, temps_c / temps_ext,
+               pi_c == etat_pi(&etat, n) ? "✓" : "✗");
+    }
+    etat_liberer(&etat);
+
+    // Petites limites: extensions de 1 en 1 contre le crible de référence
+    etat_init(&etat);
+    for (uint64_t n = 0; n <= 3000; n++) {
+        etat_etendre(&etat, n, 3);
+        if (etat_pi(&etat, n) != count_primes_crible_segmente(n, 1)) erreurs++;
+    }
+    etat_liberer(&etat);
+    printf("\n   Validation pas à pas de 0 à 3000: %s\n", erreurs == 0 ? "✓" : "✗ ERREURS");
+    return erreurs;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc > 2 && strcmp(argv[1], "etendre") == 0) {
+        uint64_t n = (uint64_t)strtod(argv[2], NULL);
+        const char *chemin = (argc > 3) ? argv[3] : ETAT_FICHIER_DEFAUT;
+
+        EtatCrible etat;
+        etat_init(&etat);
+        // Fichier absent: calcul depuis 0. Fichier invalide: on ne l'écrase pas
+        int charge = etat_charger(&etat, chemin);
+        if (charge < 0) return 1;
+        if (charge == 0) {
+            printf("Reprise depuis %s (fin = %llu)\n", chemin, (unsigned long long)etat.fin);
+        }
+        if (n + 1 < etat.fin) {
+            fprintf(stderr, "Erreur: %llu est déjà couvert (fin = %llu)\n",
+                    (unsigned long long)n, (unsigned long long)etat.fin);
+            etat_liberer(&etat);
+            return 1;
+        }
+        double start = omp_get_wtime();
+        etat_etendre(&etat, n, omp_get_max_threads());
+        double temps = omp_get_wtime() - start;
+        printf("pi(%llu) = %llu | Temps: %.4f s\n", (unsigned long long)n,
+               (unsigned long long)etat_pi(&etat, n), temps);
+        int ok = etat_sauver(&etat, chemin) == 0;
+        etat_liberer(&etat);
+        return !ok;
+    }
+
+    printf("================================================================================\n");
+    printf("  CRIBLE INCRÉMENTAL: point de reprise et extension de la limite\n");
+    printf("================================================================================\n\n");
+
+    int erreurs = demo(1000000000ull, 2000000000ull, ETAT_FICHIER_DEFAUT);
+    remove(ETAT_FICHIER_DEFAUT);
+
+    printf("\n================================================================================\n");
+    printf("ANALYSE\n");
+    printf("================================================================================\n");
+    printf("- Le point de reprise ne contient que sqrt(N) premiers et leurs multiples\n");
+    printf("- L'extension ne coûte que la nouvelle plage: ~(N' - N) / N' du recalcul\n");
+    printf("- Les prochains multiples évitent une division par premier et par segment\n");
+    printf("- Extension et calcul complet partagent le même code (état vide = 0)\n");
+
+    return erreurs != 0;
+}
@@ -0,0 +1,105 @@
+/*
+ * GENERATEUR: Réductions fusionnées avec la génération des données
+ *
+ * Bibliothèque "header-only". Dans lab2, init_array écrit le tableau en
+ * mémoire puis sum_with_* le relit: pour une entrée synthétique, la moitié
+ * du temps est du trafic mémoire inutile. Ici l'entrée est décrite par un
+ * GÉNÉRATEUR, fonction pure de l'indice, et la réduction consomme les
+ * valeurs directement dans les registres:
+ *
+ *   Matérialisé:  a[i] = g(i)  --écriture-->  [ mémoire ]  --lecture-->  s += a[i]
+ *   Fusionné:     s += g(i)                   (aucun tableau, mémoire constante)
+ *
+ * Un générateur ne dépend que de (i, graine): n'importe quel thread peut
+ * produire n'importe quelle plage, dans n'importe quel ordre. Le générateur
+ * aléatoire est donc "à compteur" (counter-based): hachage de l'indice par
+ * le finaliseur de splitmix64, sans état à faire avancer.
+ *
+ * Générateurs disponibles (nom: élément -> somme):
+ *   lineaire : i + 1                        uint64 -> uint64
+ *   motif    : i % 1000 + 1 (comme lab2)    int32  -> uint64
+ *   aleatoire: hachage(graine, i)           uint64 -> uint64
+ *   uniforme : [0, 1) tiré de aleatoire     double -> double
+ *
+ * Les sommes entières sont non signées: elles bouclent modulo 2^64 (défini
+ * en C), le résultat reste exact et indépendant de l'ordre des additions,
+ * même pour 1e11 éléments.
+ *
+ * API générée pour chaque générateur (nom = lineaire | motif | ...):
+ *   somme_gen_<nom>(debut, n, graine, num_threads)     fusionné
+ *   remplir_gen_<nom>(a, debut, n, graine, num_threads) matérialisé: a[k] = g(debut + k)
+ *   somme_tableau_<nom>(a, n, num_threads)              réduction du tableau
+ */
+
+#ifndef GENERATEUR_H
+#define GENERATEUR_H
+
+#include <stdint.h>
+#include <omp.h>
+
+// ============================================================================
+// GÉNÉRATEURS (fonctions pures de l'indice)
+// ============================================================================
+
+static inline uint64_t gen_lineaire(long i, uint64_t graine) {
+    (void)graine;
+    return (uint64_t)i + 1;
+}
+
+static inline int32_t gen_motif(long i, uint64_t graine) {
+    (void)graine;
+    return (int32_t)(i % 1000 + 1);
+}
+
+// Finaliseur de splitmix64 appliqué au compteur: pas d'état séquentiel
+static inline uint64_t gen_aleatoire(long i, uint64_t graine) {
+    uint64_t z = graine + ((uint64_t)i + 1) * 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+static inline double gen_uniforme(long i, uint64_t graine) {
+    return (gen_aleatoire(i, graine) >> 11) * 0x1.0p-53;
+}
+
+// ============================================================================
+// RÉDUCTIONS: fusionnée et matérialisée
+// ============================================================================
+
+#define DEFINIR_GENERATEUR(nom, type, type_somme)                               \
+                                                                                \
+static inline type_somme somme_gen_##nom(long debut, long n, uint64_t graine,   \
+                                         int num_threads) {                     \
+    type_somme s = 0;                                                           \
+    _Pragma("omp parallel for simd reduction(+:s) schedule(static) num_threads(num_threads)") \
+    for (long i = debut; i < debut + n; i++) {                                  \
+        s += (type_somme)gen_##nom(i, graine);                                  \
+    }                                                                           \
+    return s;                                                                   \
+}                                                                               \
+                                                                                \
+static inline void remplir_gen_##nom(type *a, long debut, long n,               \
+                                     uint64_t graine, int num_threads) {        \
+    _Pragma("omp parallel for simd schedule(static) num_threads(num_threads)")  \
+    for (long k = 0; k < n; k++) {                                              \
+        a[k] = gen_##nom(debut + k, graine);                                    \
+    }                                                                           \
+}                                                                               \
+                                                                                \
+static inline type_somme somme_tableau_##nom(const type *a, long n,             \
+                                             int num_threads) {                 \
+    type_somme s = 0;                                                           \
+    _Pragma("omp parallel for simd reduction(+:s) schedule(static) num_threads(num_threads)") \
+    for (long k = 0; k < n; k++) {                                              \
+        s += (type_somme)a[k];                                                  \
+    }                                                                           \
+    return s;                                                                   \
+}
+
+DEFINIR_GENERATEUR(lineaire, uint64_t, uint64_t)
+DEFINIR_GENERATEUR(motif, int32_t, uint64_t)
+DEFINIR_GENERATEUR(aleatoire, uint64_t, uint64_t)
+DEFINIR_GENERATEUR(uniforme, double, double)
+
+#endif
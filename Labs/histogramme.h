@@ -0,0 +1,202 @@
+/*
+ * HISTOGRAMME: Histogrammes parallèles, cases partagées ou privées
+ *
+ * Bibliothèque "header-only". Suite de lab2 (atomic vs critical vs
+ * reduction): dans un histogramme, les threads se disputent les cases, et
+ * d'autant plus que l'entrée est biaisée (toutes les valeurs dans la même
+ * case = une seule ligne de cache pour tous).
+ *
+ * Entrée: n valeurs uint32 dans [0, nb_cases). Sortie: hist[nb_cases].
+ *
+ * Stratégies:
+ * 1. ATOMIQUES PARTAGÉES: "#pragma omp atomic" sur hist[v]
+ *    Pas de mémoire supplémentaire; s'effondre si beaucoup de threads
+ *    visent les mêmes cases (entrée biaisée, peu de cases)
+ *
+ * 2. reduction(+:hist[:nb_cases]) d'OpenMP (sections de tableau, 4.5)
+ *    Copies privées gérées par le runtime, fusion non spécifiée.
+ *    GCC place les copies sur la PILE de chaque thread: au-delà de
+ *    HISTO_REDUCTION_MAX_CASES, dépassement de pile (segfault) avec les
+ *    tailles par défaut (8 Mo pour le thread maître, OMP_STACKSIZE sinon)
+ *
+ * 3. PRIVÉES + FUSION EN ARBRE: chaque thread compte dans sa copie, puis
+ *    log2(T) étapes de fusion deux à deux:
+ *
+ *      T0  T1  T2  T3        étape 1: T0 += T1, T2 += T3
+ *      |___|   |___|         étape 2: T0 += T2
+ *        |_______|           (la copie de T0 est hist)
+ *
+ *    Chaque étape relit toutes les cases: log2(T) * nb_cases par thread actif
+ *
+ * 4. PRIVÉES + FUSION PARTITIONNÉE (NUMA): chaque thread fusionne une
+ *    tranche de cases de toutes les copies et l'écrit dans hist:
+ *
+ *      hist[tranche t] = copie0[tranche t] + copie1[tranche t] + ...
+ *
+ *    Tous les threads fusionnent en même temps (nb_cases lectures chacun
+ *    au lieu de log2(T) * nb_cases pour la racine de l'arbre). hist
+ *    appartient à l'appelant: ses pages sont sur le nœud du thread qui les
+ *    a touchées en premier. histo_allouer_partitionne alloue hist et met
+ *    chaque tranche à zéro depuis le thread qui la fusionnera (même
+ *    découpage, même nombre de threads): avec OMP_PROC_BIND, chaque
+ *    tranche est alors locale à son thread.
+ *
+ * Les copies privées sont allouées et mises à zéro par leur thread
+ * (premier contact): elles sont locales au nœud NUMA du thread.
+ *
+ * API: histo_<strategie>(valeurs, n, hist, nb_cases, num_threads)
+ *      strategie = atomique | reduction | arbre | partitionne
+ *      hist = histo_allouer_partitionne(nb_cases, num_threads)  (free)
+ */
+
+#ifndef HISTOGRAMME_H
+#define HISTOGRAMME_H
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <omp.h>
+
+#define HISTO_MAX_THREADS 256
+
+// reduction(+:hist[:]): copie privée sur la pile (64K cases = 512 Ko)
+#define HISTO_REDUCTION_MAX_CASES 65536
+
+static inline void histo_sequentiel(const uint32_t *valeurs, long n, long *hist, int nb_cases) {
+    memset(hist, 0, nb_cases * sizeof(long));
+    for (long i = 0; i < n; i++) hist[valeurs[i]]++;
+}
+
+// ============================================================================
+// 1. ATOMIQUES PARTAGÉES
+// ============================================================================
+
+static inline void histo_atomique(const uint32_t *valeurs, long n, long *hist,
+                                  int nb_cases, int num_threads) {
+    #pragma omp parallel num_threads(num_threads)
+    {
+        #pragma omp for schedule(static)
+        for (int c = 0; c < nb_cases; c++) hist[c] = 0;
+
+        #pragma omp for schedule(static)
+        for (long i = 0; i < n; i++) {
+            #pragma omp atomic
+            hist[valeurs[i]]++;
+        }
+    }
+}
+
+// ============================================================================
+// 2. RÉDUCTION DE TABLEAU D'OPENMP
+// ============================================================================
+
+static inline void histo_reduction(const uint32_t *valeurs, long n, long *hist,
+                                   int nb_cases, int num_threads) {
+    memset(hist, 0, nb_cases * sizeof(long));
+    #pragma omp parallel for reduction(+:hist[:nb_cases]) schedule(static) num_threads(num_threads)
+    for (long i = 0; i < n; i++) {
+        hist[valeurs[i]]++;
+    }
+}
+
+// ============================================================================
+// 3. COPIES PRIVÉES + FUSION EN ARBRE
+// ============================================================================
+
+static inline void histo_arbre(const uint32_t *valeurs, long n, long *hist,
+                               int nb_cases, int num_threads) {
+    long *copies[HISTO_MAX_THREADS];
+    if (num_threads > HISTO_MAX_THREADS) num_threads = HISTO_MAX_THREADS;
+
+    #pragma omp parallel num_threads(num_threads)
+    {
+        int t = omp_get_thread_num();
+        int nb = omp_get_num_threads();
+
+        // La copie du thread 0 est hist: la racine de l'arbre y arrive
+        copies[t] = (t == 0) ? hist : (long*)malloc(nb_cases * sizeof(long));
+        memset(copies[t], 0, nb_cases * sizeof(long));
+        long *h = copies[t];
+
+        #pragma omp for schedule(static)
+        for (long i = 0; i < n; i++) h[valeurs[i]]++;
+        // Barrière implicite: toutes les copies sont complètes
+
+        for (int pas = 1; pas < nb; pas *= 2) {
+            if (t % (2 * pas) == 0 && t + pas < nb) {
+                const long *autre = copies[t + pas];
+                #pragma omp simd
+                for (int c = 0; c < nb_cases; c++) h[c] += autre[c];
+            }
+            #pragma omp barrier
+        }
+
+        if (t != 0) free(h);
+    }
+}
+
+// ============================================================================
+// 4. COPIES PRIVÉES + FUSION PARTITIONNÉE (NUMA)
+// ============================================================================
+
+// Tranche de cases [debut, fin) fusionnée par le thread courant
+static inline void histo_tranche(int nb_cases, int *debut, int *fin) {
+    int t = omp_get_thread_num();
+    int nb = omp_get_num_threads();
+    *debut = (int)((long)nb_cases * t / nb);
+    *fin = (int)((long)nb_cases * (t + 1) / nb);
+}
+
+// hist pour histo_partitionne avec num_threads threads: chaque tranche est
+// mise à zéro (premier contact) par le thread qui la fusionnera. NULL si
+// l'allocation échoue.
+static inline long *histo_allouer_partitionne(int nb_cases, int num_threads) {
+    long *hist = (long*)malloc(nb_cases * sizeof(long));
+    if (hist == NULL) return NULL;
+    if (num_threads > HISTO_MAX_THREADS) num_threads = HISTO_MAX_THREADS;
+
+    #pragma omp parallel num_threads(num_threads)
+    {
+        int debut, fin;
+        histo_tranche(nb_cases, &debut, &fin);
+        memset(hist + debut, 0, (fin - debut) * sizeof(long));
+    }
+    return hist;
+}
+
+static inline void histo_partitionne(const uint32_t *valeurs, long n, long *hist,
+                                     int nb_cases, int num_threads) {
+    long *copies[HISTO_MAX_THREADS];
+    if (num_threads > HISTO_MAX_THREADS) num_threads = HISTO_MAX_THREADS;
+
+    #pragma omp parallel num_threads(num_threads)
+    {
+        int t = omp_get_thread_num();
+        int nb = omp_get_num_threads();
+        int debut, fin;
+        histo_tranche(nb_cases, &debut, &fin);
+
+        // Tranche de hist placée par histo_allouer_partitionne; la copie
+        // privée est touchée ici en premier
+        memset(hist + debut, 0, (fin - debut) * sizeof(long));
+        copies[t] = (long*)malloc(nb_cases * sizeof(long));
+        memset(copies[t], 0, nb_cases * sizeof(long));
+        long *h = copies[t];
+
+        #pragma omp for schedule(static)
+        for (long i = 0; i < n; i++) h[valeurs[i]]++;
+
+        // Tous les threads fusionnent en parallèle, chacun sa tranche; décalage
+        // t + k: les threads ne lisent pas tous la même copie en même temps
+        for (int k = 0; k < nb; k++) {
+            const long *autre = copies[(t + k) % nb];
+            #pragma omp simd
+            for (int c = debut; c < fin; c++) hist[c] += autre[c];
+        }
+
+        #pragma omp barrier
+        free(h);
+    }
+}
+
+#endif
@@ -0,0 +1,385 @@
+/*
+ * INDEX DE PREMIERS: pi(x) et comptage sur [a, b] en temps constant
+ *
+ * Construction (une seule fois): crible segmenté parallèle (crible.h)
+ * écrit directement dans un fichier projeté en mémoire (mmap):
+ *
+ *   [EnteteIndex][cumul: nb_blocs + 1 compteurs][bits: 1 bit par impair]
+ *
+ * - cumul[b] = nombre de bits à 1 avant le bloc b (bloc = 2^k nombres)
+ * - bits: même convention que crible.h (bit j <-> 2j + 1, 1 = premier)
+ *
+ * Requête pi(x): une lecture dans cumul + popcount sur au plus un bloc
+ * (2^k / 128 mots de 64 bits). Comptage sur [a, b] = pi(b) - pi(a - 1).
+ * Le fichier est en lecture seule à l'usage: les threads le partagent
+ * sans synchronisation.
+ *
+ * Usage:
+ *   ./index_premiers                          # Démo: construit 1e8, valide, benchmark
+ *   ./index_premiers construire N [fichier] [k]
+ *   ./index_premiers pi X [fichier]
+ *   ./index_premiers intervalle A B [fichier]
+ *   ./index_premiers bench [fichier] [nb_requetes]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <omp.h>
+#include "crible.h"
+
+#define INDEX_MAGIQUE "PIDX0001"
+#define INDEX_FICHIER_DEFAUT "premiers.idx"
+#define INDEX_K_DEFAUT 12          // Blocs de 4096 nombres = 32 mots
+#define INDEX_K_MIN 7              // Un bloc = au moins un mot de 64 bits
+#define INDEX_K_MAX 19             // Un bloc ne dépasse pas un segment
+
+typedef struct {
+    char magique[8];
+    uint64_t limite;     // pi(x) valide pour x <= limite
+    uint64_t fin;        // Nombres couverts: [0, fin), multiple de 2^k
+    uint32_t k;          // Bloc = 2^k nombres = 2^(k-1) bits
+    uint32_t reserve;
+    uint64_t nb_blocs;
+    uint64_t nb_mots;
+} EnteteIndex;
+
+typedef struct {
+    int fd;
+    void *carte;
+    size_t taille;
+    const EnteteIndex *entete;
+    const uint64_t *cumul;
+    const uint64_t *bits;
+} IndexPremiers;
+
+static size_t taille_fichier(uint64_t nb_blocs, uint64_t nb_mots) {
+    return sizeof(EnteteIndex) + (nb_blocs + 1 + nb_mots) * sizeof(uint64_t);
+}
+
+// ============================================================================
+// CONSTRUCTION
+// ============================================================================
+
+static int index_construire(const char *chemin, uint64_t limite, uint32_t k, int num_threads) {
+    uint64_t bloc = 1ull << k;
+    uint64_t fin = (limite + 1 + bloc - 1) / bloc * bloc;
+    uint64_t nb_blocs = fin / bloc;
+    uint64_t nb_mots = fin / 128;
+    size_t taille = taille_fichier(nb_blocs, nb_mots);
+
+    int fd = open(chemin, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        fprintf(stderr, "Erreur: Impossible de créer %s\n", chemin);
+        return -1;
+    }
+    if (ftruncate(fd, (off_t)taille) != 0) {
+        fprintf(stderr, "Erreur: Impossible de dimensionner %s (%zu octets)\n", chemin, taille);
+        close(fd);
+        return -1;
+    }
+    void *carte = mmap(NULL, taille, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (carte == MAP_FAILED) {
+        fprintf(stderr, "Erreur: mmap de %s impossible\n", chemin);
+        close(fd);
+        return -1;
+    }
+
+    EnteteIndex *entete = (EnteteIndex*)carte;
+    uint64_t *cumul = (uint64_t*)(entete + 1);
+    uint64_t *bits = cumul + nb_blocs + 1;
+
+    size_t nb_base;
+    uint32_t *base = crible_premiers_base((uint32_t)crible_isqrt(fin), &nb_base);
+
+    // 1. Crible: chaque segment écrit sa tranche du fichier
+    uint64_t nb_segments = (fin + CRIBLE_SEGMENT_NOMBRES - 1) / CRIBLE_SEGMENT_NOMBRES;
+    #pragma omp parallel for schedule(dynamic, 1) num_threads(num_threads)
+    for (uint64_t s = 0; s < nb_segments; s++) {
+        uint64_t lo = s * CRIBLE_SEGMENT_NOMBRES;
+        uint64_t hi = (lo + CRIBLE_SEGMENT_NOMBRES < fin) ? lo + CRIBLE_SEGMENT_NOMBRES : fin;
+        crible_segment_impairs(base, nb_base, lo, hi, bits + lo / 128);
+    }
+    free(base);
+
+    // 2. Popcount par bloc en parallèle, puis somme préfixe séquentielle
+    uint64_t mots_par_bloc = bloc / 128;
+    cumul[0] = 0;
+    #pragma omp parallel for schedule(static) num_threads(num_threads)
+    for (uint64_t b = 0; b < nb_blocs; b++) {
+        cumul[b + 1] = crible_compter_bits(bits + b * mots_par_bloc, mots_par_bloc * 64);
+    }
+    for (uint64_t b = 1; b <= nb_blocs; b++) {
+        cumul[b] += cumul[b - 1];
+    }
+
+    // L'entête est écrit en dernier: un fichier interrompu reste invalide
+    entete->limite = limite;
+    entete->fin = fin;
+    entete->k = k;
+    entete->reserve = 0;
+    entete->nb_blocs = nb_blocs;
+    entete->nb_mots = nb_mots;
+    memcpy(entete->magique, INDEX_MAGIQUE, 8);
+
+    munmap(carte, taille);
+    close(fd);
+    return 0;
+}
+
+// ============================================================================
+// OUVERTURE ET REQUÊTES
+// ============================================================================
+
+static int index_ouvrir(IndexPremiers *idx, const char *chemin) {
+    idx->fd = open(chemin, O_RDONLY);
+    if (idx->fd < 0) {
+        fprintf(stderr, "Erreur: Impossible d'ouvrir %s\n", chemin);
+        return -1;
+    }
+    struct stat st;
+    fstat(idx->fd, &st);
+    idx->taille = (size_t)st.st_size;
+    if (idx->taille < sizeof(EnteteIndex)) {
+        fprintf(stderr, "Erreur: %s n'est pas un index de premiers\n", chemin);
+        close(idx->fd);
+        return -1;
+    }
+    idx->carte = mmap(NULL, idx->taille, PROT_READ, MAP_SHARED, idx->fd, 0);
+    if (idx->carte == MAP_FAILED) {
+        fprintf(stderr, "Erreur: mmap de %s impossible\n", chemin);
+        close(idx->fd);
+        return -1;
+    }
+
+    idx->entete = (const EnteteIndex*)idx->carte;
+    const EnteteIndex *e = idx->entete;
+    if (memcmp(e->magique, INDEX_MAGIQUE, 8) != 0 ||
+        idx->taille != taille_fichier(e->nb_blocs, e->nb_mots)) {
+        fprintf(stderr, "Erreur: %s est invalide ou incomplet\n", chemin);
+        munmap(idx->carte, idx->taille);
+        close(idx->fd);
+        return -1;
+    }
+    idx->cumul = (const uint64_t*)(e + 1);
+    idx->bits = idx->cumul + e->nb_blocs + 1;
+    return 0;
+}
+
+static void index_fermer(IndexPremiers *idx) {
+    munmap(idx->carte, idx->taille);
+    close(idx->fd);
+}
+
+// Nombre de premiers <= x (x <= limite de l'index)
+static inline uint64_t index_pi(const IndexPremiers *idx, uint64_t x) {
+    if (x < 2) return 0;
+    uint64_t j = (x + 1) / 2;                 // Bits des impairs < x + 1
+    uint32_t k = idx->entete->k;
+    uint64_t b = j >> (k - 1);
+    uint64_t count = idx->cumul[b] + 1;       // + le nombre 2
+
+    const uint64_t *mot = idx->bits + (b << (k - 1)) / 64;
+    const uint64_t *dernier = idx->bits + j / 64;
+    while (mot < dernier) {
+        count += (uint64_t)__builtin_popcountll(*mot++);
+    }
+    if (j % 64) {
+        count += (uint64_t)__builtin_popcountll(*mot & ((1ull << (j % 64)) - 1));
+    }
+    return count;
+}
+
+// Nombre de premiers dans [a, b]
+static inline uint64_t index_intervalle(const IndexPremiers *idx, uint64_t a, uint64_t b) {
+    if (b < a) return 0;
+    return index_pi(idx, b) - (a > 0 ? index_pi(idx, a - 1) : 0);
+}
+
+// ============================================================================
+// VALIDATION ET BENCHMARK
+// ============================================================================
+
+static uint64_t splitmix64(uint64_t *etat) {
+    uint64_t z = (*etat += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+static int valider(const IndexPremiers *idx) {
+    uint64_t limite = idx->entete->limite;
+    int erreurs = 0;
+
+    printf("   %-28s %15s %15s\n", "Requête", "Index", "Crible");
+    uint64_t x_tests[] = {0, 1, 2, 3, 10, 100, 1000, 4095, 4096, 4097, 1000000,
+                          limite / 3, limite - 1, limite};
+    for (size_t i = 0; i < sizeof(x_tests) / sizeof(x_tests[0]); i++) {
+        uint64_t x = x_tests[i];
+        if (x > limite) continue;
+        uint64_t attendu = count_primes_crible_segmente(x, omp_get_max_threads());
+        uint64_t obtenu = index_pi(idx, x);
+        if (obtenu != attendu) erreurs++;
+        char requete[32];
+        snprintf(requete, sizeof(requete), "pi(%llu)", (unsigned long long)x);
+        printf("   %-28s %15llu %15llu %s\n", requete, (unsigned long long)obtenu, (unsigned long long)attendu,
+               obtenu == attendu ? "✓" : "✗");
+    }
+
+    // Intervalles aléatoires: comparaison avec un crible de [0, b]
+    uint64_t etat = 7;
+    for (int i = 0; i < 4; i++) {
+        uint64_t a = splitmix64(&etat) % (limite + 1);
+        uint64_t b = splitmix64(&etat) % (limite + 1);
+        if (a > b) { uint64_t t = a; a = b; b = t; }
+        uint64_t attendu = count_primes_crible_segmente(b, omp_get_max_threads()) -
+                           (a > 0 ? count_primes_crible_segmente(a - 1, omp_get_max_threads()) : 0);
+        uint64_t obtenu = index_intervalle(idx, a, b);
+        if (obtenu != attendu) erreurs++;
+        printf("   [%llu, %llu]: %llu premiers %s\n", (unsigned long long)a,
+               (unsigned long long)b, (unsigned long long)obtenu,
+               obtenu == attendu ? "✓" : "✗");
+    }
+    return erreurs;
+}
+
+static void benchmark(const IndexPremiers *idx, long nb_requetes) {
+    uint64_t limite = idx->entete->limite;
+    int max_threads = omp_get_max_threads();
+
+    printf("   %-12s %8s %12s %16s %10s\n", "Requête", "Threads", "Temps (s)", "M requêtes/s", "Speedup");
+    for (int mode = 0; mode < 2; mode++) {
+        double temps_ref = 0;
+        for (int t = 1; t <= max_threads * 2; t *= 2) {
+            uint64_t somme = 0;
+            double start = omp_get_wtime();
+            #pragma omp parallel num_threads(t) reduction(+:somme)
+            {
+                uint64_t etat = 1000 + omp_get_thread_num();
+                #pragma omp for schedule(static)
+                for (long i = 0; i < nb_requetes; i++) {
+                    uint64_t a = splitmix64(&etat) % (limite + 1);
+                    if (mode == 0) {
+                        somme += index_pi(idx, a);
+                    } else {
+                        uint64_t b = splitmix64(&etat) % (limite + 1);
+                        somme += (a < b) ? index_intervalle(idx, a, b) : index_intervalle(idx, b, a);
+                    }
+                }
+            }
+            double temps = omp_get_wtime() - start;
+            if (t == 1) temps_ref = temps;
+            printf("   %-12s %8d %12.4f %16.2f %9.2fx   (somme %llu)\n",
+                   mode == 0 ? "pi(x)" : "[a, b]", t, temps,
+                   nb_requetes / temps * 1e-6, temps_ref / temps, (unsigned long long)somme);
+        }
+    }
+
+    double start = omp_get_wtime();
+    uint64_t pi = count_primes_crible_segmente(limite, max_threads);
+    double temps_crible = omp_get_wtime() - start;
+    printf("\n   Référence: recalcul de pi(%llu) = %llu par le crible: %.4f s par requête\n",
+           (unsigned long long)limite, (unsigned long long)pi, temps_crible);
+}
+
+static int commande_construire(const char *chemin, uint64_t limite, uint32_t k) {
+    if (k < INDEX_K_MIN || k > INDEX_K_MAX) {
+        fprintf(stderr, "Erreur: k doit être entre %d et %d\n", INDEX_K_MIN, INDEX_K_MAX);
+        return -1;
+    }
+    double start = omp_get_wtime();
+    if (index_construire(chemin, limite, k, omp_get_max_threads()) != 0) return -1;
+    double temps = omp_get_wtime() - start;
+
+    IndexPremiers idx;
+    if (index_ouvrir(&idx, chemin) != 0) return -1;
+    printf("   Index %s: limite %llu, blocs de 2^%u nombres\n", chemin,
+           (unsigned long long)limite, k);
+    printf("   Taille: %.2f Mo (compteurs: %.2f Mo, bits: %.2f Mo) | Construction: %.4f s\n",
+           idx.taille / 1e6, (idx.entete->nb_blocs + 1) * 8 / 1e6,
+           idx.entete->nb_mots * 8 / 1e6, temps);
+    index_fermer(&idx);
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc > 2 && strcmp(argv[1], "construire") == 0) {
+        uint64_t limite = (uint64_t)strtod(argv[2], NULL);
+        const char *chemin = (argc > 3) ? argv[3] : INDEX_FICHIER_DEFAUT;
+        uint32_t k = (argc > 4) ? (uint32_t)atoi(argv[4]) : INDEX_K_DEFAUT;
+        return commande_construire(chemin, limite, k) != 0;
+    }
+
+    if (argc > 2 && (strcmp(argv[1], "pi") == 0 || strcmp(argv[1], "intervalle") == 0)) {
+        int intervalle = (strcmp(argv[1], "intervalle") == 0);
+        if (intervalle && argc < 4) {
+            fprintf(stderr, "Usage: %s intervalle A B [fichier]\n", argv[0]);
+            return 1;
+        }
+        uint64_t a = (uint64_t)strtod(argv[2], NULL);
+        uint64_t b = intervalle ? (uint64_t)strtod(argv[3], NULL) : a;
+        const char *chemin = (argc > 3 + intervalle) ? argv[3 + intervalle] : INDEX_FICHIER_DEFAUT;
+
+        IndexPremiers idx;
+        if (index_ouvrir(&idx, chemin) != 0) return 1;
+        if (b > idx.entete->limite) {
+            fprintf(stderr, "Erreur: %llu dépasse la limite de l'index (%llu)\n",
+                    (unsigned long long)b, (unsigned long long)idx.entete->limite);
+            index_fermer(&idx);
+            return 1;
+        }
+        if (intervalle) {
+            printf("Premiers dans [%llu, %llu]: %llu\n", (unsigned long long)a,
+                   (unsigned long long)b, (unsigned long long)index_intervalle(&idx, a, b));
+        } else {
+            printf("pi(%llu) = %llu\n", (unsigned long long)a,
+                   (unsigned long long)index_pi(&idx, a));
+        }
+        index_fermer(&idx);
+        return 0;
+    }
+
+    if (argc > 1 && strcmp(argv[1], "bench") == 0) {
+        const char *chemin = (argc > 2) ? argv[2] : INDEX_FICHIER_DEFAUT;
+        long nb_requetes = (argc > 3) ? (long)strtod(argv[3], NULL) : 10000000;
+        IndexPremiers idx;
+        if (index_ouvrir(&idx, chemin) != 0) return 1;
+        benchmark(&idx, nb_requetes);
+        index_fermer(&idx);
+        return 0;
+    }
+
+    printf("================================================================================\n");
+    printf("  INDEX DE PREMIERS PRÉCALCULÉ (mmap): pi(x) et intervalles en O(1)\n");
+    printf("================================================================================\n\n");
+
+    printf("1. CONSTRUCTION\n");
+    if (commande_construire(INDEX_FICHIER_DEFAUT, 100000000, INDEX_K_DEFAUT) != 0) return 1;
+    printf("\n");
+
+    IndexPremiers idx;
+    if (index_ouvrir(&idx, INDEX_FICHIER_DEFAUT) != 0) return 1;
+
+    printf("2. VALIDATION (contre count_primes_crible_segmente)\n");
+    int erreurs = valider(&idx);
+    printf("   %s\n\n", erreurs == 0 ? "✓ Tous les résultats sont corrects" : "✗ ERREURS");
+
+    printf("3. BENCHMARK: 1e7 requêtes aléatoires\n");
+    benchmark(&idx, 10000000);
+    index_fermer(&idx);
+
+    printf("\n================================================================================\n");
+    printf("ANALYSE\n");
+    printf("================================================================================\n");
+    printf("- Une requête lit 1 compteur + au plus 2^k/128 mots: coût indépendant de x\n");
+    printf("- Le fichier est en lecture seule: aucun verrou entre threads\n");
+    printf("- Le débit dépend surtout des défauts de cache sur les bits (accès aléatoires)\n");
+    printf("- k plus grand = table plus petite mais popcount plus long par requête\n");
+
+    return erreurs != 0;
+}
@@ -0,0 +1,549 @@
+/*
+ * JOURNAL: Journalisation binaire asynchrone sans verrou
+ *
+ * Bibliothèque "header-only" (C11 + pthreads). Les labs écrivent leurs
+ * diagnostics avec printf dans une section critical: chaque message
+ * sérialise la région parallèle et paie le formatage + l'appel système.
+ *
+ * Principe:
+ * - Un anneau par thread (un producteur, un consommateur): JOURNAL()
+ *   copie l'horodatage, l'ADRESSE du format et au plus JOURNAL_MAX_ARGS
+ *   arguments numériques dans un enregistrement de 64 octets. Aucun
+ *   formatage, aucun verrou, aucun appel système: quelques ns.
+ * - Un thread écrivain vide les anneaux dans un tampon de
+ *   JOURNAL_TAMPON octets, écrit par gros write(), et dort quand il n'y a
+ *   rien à faire.
+ * - Registre des formats: la première fois qu'il voit une adresse de
+ *   format, l'écrivain insère le texte du format dans le fichier.
+ * - Le formatage est fait plus tard par journal_decoder() (ou l'outil
+ *   journal_lire), qui trie les messages de tous les threads par date.
+ *
+ *   thread 0 ──> [anneau 0] ──┐
+ *   thread 1 ──> [anneau 1] ──┼──> écrivain ──> write(fichier.journal)
+ *   thread 2 ──> [anneau 2] ──┘                        │
+ *                                         journal_decoder (texte)
+ *
+ * Limites:
+ * - Le format doit rester valide jusqu'à journal_fermer (littéral)
+ * - Arguments numériques seulement (entiers, flottants): une chaîne (%s)
+ *   serait copiée comme adresse et n'est pas décodée
+ * - Anneau plein: le message est perdu (compté), le producteur n'attend
+ *   jamais l'écrivain
+ *
+ * Utilisation:
+ *
+ *   Journal j;
+ *   journal_ouvrir(&j, "calcul.journal", nb_threads, 4096);
+ *   #pragma omp parallel num_threads(nb_threads)
+ *   {
+ *       int id = omp_get_thread_num();
+ *       JOURNAL(&j, id, "thread %d: i = %ld, x = %.3f", id, i, x);
+ *   }
+ *   journal_fermer(&j);
+ *   journal_decoder("calcul.journal", stdout);
+ *
+ * Compilation: gcc -fopenmp -O2 ... -pthread
+ */
+
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <time.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#define JOURNAL_LIGNE_CACHE 64
+#define JOURNAL_MAX_ARGS 5
+#define JOURNAL_TAMPON (1 << 20)         // Tampon de l'écrivain: 1 Mo
+#define JOURNAL_MAX_FORMATS 4096         // Puissance de 2
+#define JOURNAL_SOMMEIL_NS 1000000       // Écrivain sans travail: 1 ms
+#define JOURNAL_MAGIE "JOURNAL1"
+
+enum { JOURNAL_MESSAGE = 0, JOURNAL_FORMAT = 1 };
+
+// Une ligne de cache. JOURNAL_FORMAT: args[0] = longueur du texte, qui
+// suit l'enregistrement (complété par des 0 jusqu'à un multiple de 8)
+typedef struct {
+    uint64_t temps;              // ns (CLOCK_MONOTONIC)
+    uint64_t format;             // Adresse du format = identifiant
+    uint32_t thread;
+    uint16_t type;
+    uint16_t nb_args;
+    uint64_t args[JOURNAL_MAX_ARGS];
+} JournalEnregistrement;
+
+typedef struct {
+    char magie[8];
+    uint64_t t0;
+    uint32_t nb_threads;
+    uint32_t taille_enregistrement;
+} JournalEntete;
+
+// Anneau d'un thread: côté producteur et côté écrivain sur des lignes
+// séparées; le producteur garde une copie de "queue" pour ne lire la
+// ligne de l'écrivain que lorsque l'anneau paraît plein
+typedef struct {
+    _Alignas(JOURNAL_LIGNE_CACHE) _Atomic uint64_t tete;
+    uint64_t queue_vue;
+    _Atomic uint64_t perdus;
+    _Alignas(JOURNAL_LIGNE_CACHE) _Atomic uint64_t queue;
+} JournalAnneau;
+
+// Table adresse de format -> texte (adressage ouvert, 0 = case vide)
+typedef struct {
+    uint64_t cles[JOURNAL_MAX_FORMATS];
+    const char *textes[JOURNAL_MAX_FORMATS];
+    int nb;
+} JournalFormats;
+
+typedef struct {
+    int nb_threads;
+    uint64_t capacite;           // Enregistrements par anneau (puissance de 2)
+    JournalAnneau *anneaux;
+    JournalEnregistrement *enregistrements;   // nb_threads * capacite
+
+    int fd;
+    pthread_t ecrivain;
+    atomic_int arreter;
+    char *tampon;
+    size_t rempli;
+    JournalFormats *formats;     // Propre à l'écrivain
+    int erreur_ecriture;
+
+    uint64_t nb_messages;        // Écrits dans le fichier
+    uint64_t nb_octets;
+    uint64_t nb_write;           // Appels write()
+} Journal;
+
+static inline uint64_t journal_horloge(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+// ============================================================================
+// REGISTRE DES FORMATS
+// ============================================================================
+
+static inline int journal_formats_case(const JournalFormats *t, uint64_t cle) {
+    uint64_t h = (cle >> 3) * 0x9E3779B97F4A7C15ull;
+    int i = (int)(h >> 52) & (JOURNAL_MAX_FORMATS - 1);
+    while (t->cles[i] != 0 && t->cles[i] != cle) i = (i + 1) & (JOURNAL_MAX_FORMATS - 1);
+    return i;
+}
+
+static inline const char *journal_formats_chercher(const JournalFormats *t, uint64_t cle) {
+    int i = journal_formats_case(t, cle);
+    return (t->cles[i] == cle) ? t->textes[i] : NULL;
+}
+
+// Retourne 0 si la table est pleine (garder une case vide pour la recherche)
+static inline int journal_formats_ajouter(JournalFormats *t, uint64_t cle, const char *texte) {
+    if (t->nb >= JOURNAL_MAX_FORMATS - 1) return 0;
+    int i = journal_formats_case(t, cle);
+    if (t->cles[i] == 0) t->nb++;
+    t->cles[i] = cle;
+    t->textes[i] = texte;
+    return 1;
+}
+
+// ============================================================================
+// PRODUCTEURS
+// ============================================================================
+
+static inline uint64_t journal_entier(int64_t v) { return (uint64_t)v; }
+
+static inline uint64_t journal_flottant(double v) {
+    uint64_t u;
+    memcpy(&u, &v, sizeof(u));
+    return u;
+}
+
+#define JOURNAL_ARG(x) _Generic((x), float: journal_flottant, double: journal_flottant, \
+                                     default: journal_entier)(x)
+
+// Retourne 1 si le message est enregistré, 0 s'il est perdu (anneau plein)
+static inline int journal_ecrire(Journal *j, int id, const char *format,
+                                 int nb_args, const uint64_t *args) {
+    JournalAnneau *a = &j->anneaux[id];
+    uint64_t tete = atomic_load_explicit(&a->tete, memory_order_relaxed);
+    if (tete - a->queue_vue >= j->capacite) {
+        a->queue_vue = atomic_load_explicit(&a->queue, memory_order_acquire);
+        if (tete - a->queue_vue >= j->capacite) {
+            atomic_store_explicit(&a->perdus,
+                                  atomic_load_explicit(&a->perdus, memory_order_relaxed) + 1,
+                                  memory_order_relaxed);
+            return 0;
+        }
+    }
+    JournalEnregistrement *e = &j->enregistrements[(uint64_t)id * j->capacite +
+                                                   (tete & (j->capacite - 1))];
+    e->temps = journal_horloge();
+    e->format = (uint64_t)(uintptr_t)format;
+    e->thread = (uint32_t)id;
+    e->type = JOURNAL_MESSAGE;
+    e->nb_args = (uint16_t)nb_args;
+    for (int k = 0; k < JOURNAL_MAX_ARGS; k++) e->args[k] = args[k];
+    atomic_store_explicit(&a->tete, tete + 1, memory_order_release);
+    return 1;
+}
+
+// JOURNAL(j, id, format, ...): au plus JOURNAL_MAX_ARGS arguments numériques
+#define JOURNAL_NB_(_0, _1, _2, _3, _4, _5, N, ...) N
+#define JOURNAL_NB(...) JOURNAL_NB_(_, ##__VA_ARGS__, 5, 4, 3, 2, 1, 0)
+#define JOURNAL_CONV_0() 0
+#define JOURNAL_CONV_1(a) JOURNAL_ARG(a)
+#define JOURNAL_CONV_2(a, b) JOURNAL_ARG(a), JOURNAL_ARG(b)
+#define JOURNAL_CONV_3(a, b, c) JOURNAL_CONV_2(a, b), JOURNAL_ARG(c)
+#define JOURNAL_CONV_4(a, b, c, d) JOURNAL_CONV_3(a, b, c), JOURNAL_ARG(d)
+#define JOURNAL_CONV_5(a, b, c, d, e) JOURNAL_CONV_4(a, b, c, d), JOURNAL_ARG(e)
+#define JOURNAL_CAT_(a, b) a##b
+#define JOURNAL_CAT(a, b) JOURNAL_CAT_(a, b)
+
+#define JOURNAL(j, id, format, ...)                                             \
+    journal_ecrire((j), (id), (format), JOURNAL_NB(__VA_ARGS__),                \
+                   (const uint64_t[JOURNAL_MAX_ARGS]){                          \
+                       JOURNAL_CAT(JOURNAL_CONV_, JOURNAL_NB(__VA_ARGS__))(__VA_ARGS__) })
+
+// ============================================================================
+// ÉCRIVAIN
+// ============================================================================
+
+// write() complet (reprise après écriture partielle ou signal)
+static inline int journal_write(int fd, const void *donnees, size_t taille) {
+    const char *p = (const char*)donnees;
+    while (taille > 0) {
+        ssize_t n = write(fd, p, taille);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        p += n;
+        taille -= (size_t)n;
+    }
+    return 0;
+}
+
+static inline void journal_vider_tampon(Journal *j) {
+    if (j->rempli == 0) return;
+    if (journal_write(j->fd, j->tampon, j->rempli) != 0 && !j->erreur_ecriture) {
+        fprintf(stderr, "Erreur: Écriture du journal impossible (%s)\n", strerror(errno));
+        j->erreur_ecriture = 1;
+    }
+    j->nb_octets += j->rempli;
+    j->nb_write++;
+    j->rempli = 0;
+}
+
+static inline void journal_ajouter(Journal *j, const void *donnees, size_t taille) {
+    if (j->rempli + taille > JOURNAL_TAMPON) journal_vider_tampon(j);
+    memcpy(j->tampon + j->rempli, donnees, taille);
+    j->rempli += taille;
+}
+
+// Insère la définition du format avant son premier message
+static inline void journal_definir_format(Journal *j, const JournalEnregistrement *e) {
+    const char *texte = (const char*)(uintptr_t)e->format;
+    if (journal_formats_chercher(j->formats, e->format) != NULL) return;
+    size_t longueur = strlen(texte);
+    if (longueur > JOURNAL_TAMPON / 2) longueur = JOURNAL_TAMPON / 2;
+    size_t complete = (longueur + 8) & ~(size_t)7;      // Au moins un 0 final
+
+    JournalEnregistrement def = {0};
+    def.format = e->format;
+    def.type = JOURNAL_FORMAT;
+    def.args[0] = longueur;
+    journal_ajouter(j, &def, sizeof(def));
+    if (j->rempli + complete > JOURNAL_TAMPON) journal_vider_tampon(j);
+    memset(j->tampon + j->rempli, 0, complete);
+    memcpy(j->tampon + j->rempli, texte, longueur);
+    j->rempli += complete;
+    // Table pleine: la définition sera répétée à chaque message (correct)
+    journal_formats_ajouter(j->formats, e->format, texte);
+}
+
+// Un passage sur tous les anneaux; retourne le nombre de messages copiés
+static inline uint64_t journal_drainer(Journal *j) {
+    uint64_t total = 0;
+    for (int id = 0; id < j->nb_threads; id++) {
+        JournalAnneau *a = &j->anneaux[id];
+        uint64_t queue = atomic_load_explicit(&a->queue, memory_order_relaxed);
+        uint64_t tete = atomic_load_explicit(&a->tete, memory_order_acquire);
+        JournalEnregistrement *base = &j->enregistrements[(uint64_t)id * j->capacite];
+        for (; queue < tete; queue++) {
+            const JournalEnregistrement *e = &base[queue & (j->capacite - 1)];
+            journal_definir_format(j, e);
+            journal_ajouter(j, e, sizeof(*e));
+            total++;
+        }
+        // Les cases lues redeviennent disponibles pour le producteur
+        atomic_store_explicit(&a->queue, queue, memory_order_release);
+    }
+    j->nb_messages += total;
+    return total;
+}
+
+static void *journal_boucle_ecrivain(void *arg) {
+    Journal *j = (Journal*)arg;
+    struct timespec sommeil = {0, JOURNAL_SOMMEIL_NS};
+    while (!atomic_load_explicit(&j->arreter, memory_order_acquire)) {
+        if (journal_drainer(j) == 0) {
+            // Rien de neuf: écrire ce qui attend, puis dormir
+            journal_vider_tampon(j);
+            nanosleep(&sommeil, NULL);
+        }
+    }
+    journal_drainer(j);     // Messages écrits avant l'arrêt
+    return NULL;
+}
+
+// ============================================================================
+// OUVERTURE / FERMETURE
+// ============================================================================
+
+// capacite: messages par thread (arrondie à une puissance de 2)
+static inline int journal_ouvrir(Journal *j, const char *fichier, int nb_threads, size_t capacite) {
+    memset(j, 0, sizeof(*j));
+    j->capacite = 1;
+    while (j->capacite < capacite) j->capacite *= 2;
+    j->nb_threads = nb_threads;
+
+    j->fd = open(fichier, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (j->fd < 0) {
+        fprintf(stderr, "Erreur: Impossible de créer le journal %s\n", fichier);
+        return -1;
+    }
+    j->anneaux = (JournalAnneau*)aligned_alloc(JOURNAL_LIGNE_CACHE,
+                                               nb_threads * sizeof(JournalAnneau));
+    j->enregistrements = (JournalEnregistrement*)aligned_alloc(
+        JOURNAL_LIGNE_CACHE, (size_t)nb_threads * j->capacite * sizeof(JournalEnregistrement));
+    j->tampon = (char*)malloc(JOURNAL_TAMPON);
+    j->formats = (JournalFormats*)calloc(1, sizeof(JournalFormats));
+    if (!j->anneaux || !j->enregistrements || !j->tampon || !j->formats) {
+        fprintf(stderr, "Erreur: Allocation du journal impossible\n");
+        free(j->anneaux); free(j->enregistrements); free(j->tampon); free(j->formats);
+        close(j->fd);
+        return -1;
+    }
+    for (int i = 0; i < nb_threads; i++) {
+        atomic_init(&j->anneaux[i].tete, 0);
+        atomic_init(&j->anneaux[i].queue, 0);
+        atomic_init(&j->anneaux[i].perdus, 0);
+        j->anneaux[i].queue_vue = 0;
+    }
+    atomic_init(&j->arreter, 0);
+
+    JournalEntete entete = {JOURNAL_MAGIE, journal_horloge(), (uint32_t)nb_threads,
+                            (uint32_t)sizeof(JournalEnregistrement)};
+    journal_ajouter(j, &entete, sizeof(entete));
+
+    if (pthread_create(&j->ecrivain, NULL, journal_boucle_ecrivain, j) != 0) {
+        fprintf(stderr, "Erreur: Impossible de lancer le thread écrivain\n");
+        free(j->anneaux); free(j->enregistrements); free(j->tampon); free(j->formats);
+        close(j->fd);
+        return -1;
+    }
+    return 0;
+}
+
+// Arrête l'écrivain, écrit le reste; retourne le nombre de messages perdus
+static inline uint64_t journal_fermer(Journal *j) {
+    atomic_store_explicit(&j->arreter, 1, memory_order_release);
+    pthread_join(j->ecrivain, NULL);
+
+    uint64_t perdus = 0;
+    for (int i = 0; i < j->nb_threads; i++) perdus += atomic_load(&j->anneaux[i].perdus);
+    if (perdus > 0) {
+        static const char *format_perdus = "journal: %lu messages perdus (anneau plein)";
+        JournalEnregistrement e = {0};
+        e.temps = journal_horloge();
+        e.format = (uint64_t)(uintptr_t)format_perdus;
+        e.nb_args = 1;
+        e.args[0] = perdus;
+        journal_definir_format(j, &e);
+        journal_ajouter(j, &e, sizeof(e));
+    }
+    journal_vider_tampon(j);
+    close(j->fd);
+
+    free(j->anneaux);
+    free(j->enregistrements);
+    free(j->tampon);
+    free(j->formats);
+    j->anneaux = NULL;
+    j->enregistrements = NULL;
+    j->tampon = NULL;
+    j->formats = NULL;
+    return perdus;
+}
+
+// ============================================================================
+// POST-TRAITEMENT
+// ============================================================================
+
+// printf d'un format avec des arguments bruts: chaque conversion est
+// réécrite (entiers en "ll") et imprimée avec son seul argument
+static inline void journal_formater(FILE *sortie, const char *format,
+                                    int nb_args, const uint64_t *args) {
+    int k = 0;
+    const char *p = format;
+    while (*p) {
+        const char *pct = strchr(p, '%');
+        if (pct == NULL) {
+            fputs(p, sortie);
+            return;
+        }
+        fwrite(p, 1, (size_t)(pct - p), sortie);
+        if (pct[1] == '%') {
+            fputc('%', sortie);
+            p = pct + 2;
+            continue;
+        }
+        // %[drapeaux][largeur][.précision][longueur]conversion
+        const char *q = pct + 1;
+        while (*q && strchr("-+ #0'", *q)) q++;
+        while (*q >= '0' && *q <= '9') q++;
+        if (*q == '.') {
+            q++;
+            while (*q >= '0' && *q <= '9') q++;
+        }
+        const char *fin_precision = q;
+        while (*q && strchr("hlLqjzt", *q)) q++;
+        char conversion = *q;
+        if (conversion == '\0') {
+            fputs(pct, sortie);
+            return;
+        }
+        p = q + 1;
+
+        char spec[64];
+        int n = (int)(fin_precision - pct);
+        if (n > 40 || k >= nb_args) {
+            fwrite(pct, 1, (size_t)(p - pct), sortie);   // Non décodable: tel quel
+            continue;
+        }
+        memcpy(spec, pct, (size_t)n);
+        uint64_t v = args[k++];
+        switch (conversion) {
+        case 'd': case 'i':
+            snprintf(spec + n, sizeof(spec) - n, "lld");
+            fprintf(sortie, spec, (long long)v);
+            break;
+        case 'u': case 'x': case 'X': case 'o':
+            snprintf(spec + n, sizeof(spec) - n, "ll%c", conversion);
+            fprintf(sortie, spec, (unsigned long long)v);
+            break;
+        case 'c':
+            snprintf(spec + n, sizeof(spec) - n, "c");
+            fprintf(sortie, spec, (int)v);
+            break;
+        case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A': {
+            double d;
+            memcpy(&d, &v, sizeof(d));
+            snprintf(spec + n, sizeof(spec) - n, "%c", conversion);
+            fprintf(sortie, spec, d);
+            break;
+        }
+        case 'p':
+            fprintf(sortie, "%p", (void*)(uintptr_t)v);
+            break;
+        default:        // %s et autres: seule l'adresse a été copiée
+            fprintf(sortie, "<%%%c 0x%llx>", conversion, (unsigned long long)v);
+            break;
+        }
+    }
+}
+
+static int journal_comparer(const void *a, const void *b) {
+    const JournalEnregistrement *x = *(const JournalEnregistrement* const*)a;
+    const JournalEnregistrement *y = *(const JournalEnregistrement* const*)b;
+    if (x->temps != y->temps) return (x->temps < y->temps) ? -1 : 1;
+    if (x->thread != y->thread) return (x->thread < y->thread) ? -1 : 1;
+    return (x < y) ? -1 : (x > y);      // Ordre du fichier pour un même thread
+}
+
+// Une ligne par message, triés par date:
+//   [    0.001234 s] T2 | texte formaté
+// Retourne le nombre de messages, -1 en cas d'erreur
+static inline long journal_decoder(const char *fichier, FILE *sortie) {
+    FILE *f = fopen(fichier, "rb");
+    if (f == NULL) {
+        fprintf(stderr, "Erreur: Impossible d'ouvrir le journal %s\n", fichier);
+        return -1;
+    }
+    fseek(f, 0, SEEK_END);
+    long taille = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    char *donnees = (char*)malloc(taille > 0 ? (size_t)taille : 1);
+    JournalEntete entete;
+    if (donnees == NULL || taille < (long)sizeof(entete) ||
+        fread(donnees, 1, (size_t)taille, f) != (size_t)taille) {
+        fprintf(stderr, "Erreur: Lecture du journal %s impossible\n", fichier);
+        fclose(f);
+        free(donnees);
+        return -1;
+    }
+    fclose(f);
+    memcpy(&entete, donnees, sizeof(entete));
+    if (memcmp(entete.magie, JOURNAL_MAGIE, 8) != 0 ||
+        entete.taille_enregistrement != sizeof(JournalEnregistrement)) {
+        fprintf(stderr, "Erreur: %s n'est pas un journal valide\n", fichier);
+        free(donnees);
+        return -1;
+    }
+
+    // Les enregistrements sont alignés sur 8 dans le fichier
+    JournalFormats *formats = (JournalFormats*)calloc(1, sizeof(JournalFormats));
+    long capacite = taille / (long)sizeof(JournalEnregistrement) + 1;
+    const JournalEnregistrement **messages =
+        (const JournalEnregistrement**)malloc(capacite * sizeof(*messages));
+    if (formats == NULL || messages == NULL) {
+        fprintf(stderr, "Erreur: Mémoire insuffisante pour décoder %s\n", fichier);
+        free(formats);
+        free(messages);
+        free(donnees);
+        return -1;
+    }
+    long nb = 0;
+    size_t pos = sizeof(entete);
+    while (pos + sizeof(JournalEnregistrement) <= (size_t)taille) {
+        const JournalEnregistrement *e = (const JournalEnregistrement*)(donnees + pos);
+        pos += sizeof(JournalEnregistrement);
+        if (e->type == JOURNAL_FORMAT) {
+            size_t complete = (e->args[0] + 8) & ~(uint64_t)7;
+            if (pos + complete > (size_t)taille) break;
+            journal_formats_ajouter(formats, e->format, donnees + pos);
+            pos += complete;
+        } else {
+            messages[nb++] = e;
+        }
+    }
+    qsort(messages, nb, sizeof(*messages), journal_comparer);
+
+    for (long i = 0; i < nb; i++) {
+        const JournalEnregistrement *e = messages[i];
+        const char *format = journal_formats_chercher(formats, e->format);
+        fprintf(sortie, "[%12.6f s] T%u | ", (double)(int64_t)(e->temps - entete.t0) * 1e-9,
+                e->thread);
+        if (format != NULL) {
+            journal_formater(sortie, format, e->nb_args, e->args);
+        } else {
+            fprintf(sortie, "<format inconnu 0x%llx>", (unsigned long long)e->format);
+        }
+        fputc('\n', sortie);
+    }
+
+    free(messages);
+    free(formats);
+    free(donnees);
+    return nb;
+}
+
+#endif
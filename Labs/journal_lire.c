@@ -0,0 +1,31 @@
+/*
+ * JOURNAL_LIRE: Décode un journal binaire (journal.h) en texte
+ *
+ * Les messages de tous les threads sont triés par date et formatés ici,
+ * hors de l'exécution mesurée.
+ *
+ * Usage: ./journal_lire fichier.journal [sortie.log]   (défaut: stdout)
+ */
+
+#include <stdio.h>
+#include "journal.h"
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        fprintf(stderr, "Usage: %s fichier.journal [sortie.log]\n", argv[0]);
+        return 1;
+    }
+    FILE *sortie = stdout;
+    if (argc > 2) {
+        sortie = fopen(argv[2], "w");
+        if (sortie == NULL) {
+            fprintf(stderr, "Erreur: Impossible de créer le fichier %s\n", argv[2]);
+            return 1;
+        }
+    }
+    long nb = journal_decoder(argv[1], sortie);
+    if (sortie != stdout) fclose(sortie);
+    if (nb < 0) return 1;
+    fprintf(stderr, "%ld messages décodés\n", nb);
+    return 0;
+}
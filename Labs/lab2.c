@@ -1,6 +1,13 @@
 #include <omp.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "memoire.h"
 
 // Fonction pour initialiser un tableau
 void init_array(int *arr, int size) {
@@ -106,6 +113,84 @@ long long sum_with_critical(int *arr, int size) {
     return sum;
 }
 
+// Méthode 4: Réductions vectorisées (SIMD)
+/*
+ * PROBLÈME DE sum_with_reduction:
+ * À -O2, "sum += arr[i]" dans un long long donne souvent une boucle
+ * scalaire: chaque addition attend la précédente (chaîne de dépendance).
+ * Pour les flottants, le compilateur n'a même PAS LE DROIT de vectoriser
+ * (l'addition n'est pas associative) sans -ffast-math.
+ *
+ * SOLUTIONS:
+ * - "omp simd reduction": autorise le compilateur à réordonner les
+ *   additions et à utiliser les registres vectoriels (SSE/AVX)
+ * - Plusieurs accumulateurs indépendants (déroulage): NB_ACCUMULATEURS
+ *   chaînes en parallèle masquent la latence de l'addition
+ * - Additions élargissantes: int32 -> int64 et float -> double, pour ne
+ *   pas déborder ni perdre de précision
+ *
+ *   Scalaire:     sum += a0; sum += a1; sum += a2; ...   (1 chaîne)
+ *
+ *   Vectorisé:    [s0 s1 s2 s3] += [a0 a1 a2 a3]
+ *                 [s4 s5 s6 s7] += [a4 a5 a6 a7]   (plusieurs chaînes)
+ *                 ...
+ *                 sum = s0 + s1 + ... + s7          (à la fin seulement)
+ *
+ * Les trois noyaux sont générés pour chaque couple (élément, somme):
+ *   int32 -> int64, float -> double, double -> double
+ */
+#define NB_ACCUMULATEURS 16
+
+#define DEFINIR_SOMMES(nom, type_elem, type_somme)                              \
+/* Référence: même boucle que sum_with_reduction */                             \
+type_somme somme_reduction_##nom(const type_elem *arr, long size) {             \
+    type_somme sum = 0;                                                         \
+    _Pragma("omp parallel for reduction(+:sum) num_threads(4)")                 \
+    for (long i = 0; i < size; i++) {                                           \
+        sum += arr[i];                                                          \
+    }                                                                           \
+    return sum;                                                                 \
+}                                                                               \
+                                                                                \
+/* omp simd: le compilateur vectorise et réordonne les additions */             \
+type_somme somme_simd_##nom(const type_elem *arr, long size) {                  \
+    type_somme sum = 0;                                                         \
+    _Pragma("omp parallel for simd reduction(+:sum) num_threads(4)")            \
+    for (long i = 0; i < size; i++) {                                           \
+        sum += (type_somme)arr[i];                                              \
+    }                                                                           \
+    return sum;                                                                 \
+}                                                                               \
+                                                                                \
+/* NB_ACCUMULATEURS sommes partielles par thread, une par voie */               \
+type_somme somme_accumulateurs_##nom(const type_elem *arr, long size) {         \
+    type_somme sum = 0;                                                         \
+    long nb_blocs = size / NB_ACCUMULATEURS;                                    \
+    _Pragma("omp parallel num_threads(4) reduction(+:sum)")                     \
+    {                                                                           \
+        type_somme acc[NB_ACCUMULATEURS] = {0};                                 \
+        _Pragma("omp for schedule(static)")                                     \
+        for (long b = 0; b < nb_blocs; b++) {                                   \
+            const type_elem *bloc = arr + b * NB_ACCUMULATEURS;                 \
+            _Pragma("omp simd")                                                 \
+            for (int k = 0; k < NB_ACCUMULATEURS; k++) {                        \
+                acc[k] += (type_somme)bloc[k];                                  \
+            }                                                                   \
+        }                                                                       \
+        for (int k = 0; k < NB_ACCUMULATEURS; k++) {                            \
+            sum += acc[k];                                                      \
+        }                                                                       \
+    }                                                                           \
+    for (long i = nb_blocs * NB_ACCUMULATEURS; i < size; i++) {                 \
+        sum += arr[i];                                                          \
+    }                                                                           \
+    return sum;                                                                 \
+}
+
+DEFINIR_SOMMES(int32, int, long long)
+DEFINIR_SOMMES(float, float, double)
+DEFINIR_SOMMES(double, double, double)
+
 // Fonction de test pour une taille donnée
 void test_size(int size) {
     printf("\n==== Taille du tableau: %d éléments ====\n", size);
@@ -153,6 +238,283 @@ void test_size(int size) {
     free(arr);
 }
 
+// Répète un noyau pour que la mesure dure assez longtemps (petites tailles)
+#define MESURER(resultat, appel, repetitions, temps) do {                       \
+    double debut_ = omp_get_wtime();                                            \
+    for (int r_ = 0; r_ < (repetitions); r_++) {                                \
+        resultat = (appel);                                                     \
+    }                                                                           \
+    (temps) = (omp_get_wtime() - debut_) / (repetitions);                       \
+} while (0)
+
+// Bande passante de référence: memcpy (lecture + écriture), plafonnée à 256 Mo
+static double debit_memcpy(const void *source, size_t octets) {
+    size_t max_octets = (size_t)256 << 20;
+    if (octets > max_octets) octets = max_octets;
+    // Appel via un pointeur volatile: le compilateur ne peut pas supprimer
+    // des copies dont la destination n'est jamais relue
+    void *(*volatile copier)(void*, const void*, size_t) = memcpy;
+    void *dest = malloc(octets);
+    copier(dest, source, octets);  // Premier contact: pas dans la mesure
+    int repetitions = (int)(((size_t)1 << 28) / octets) + 1;
+    double start = omp_get_wtime();
+    for (int r = 0; r < repetitions; r++) {
+        copier(dest, source, octets);
+    }
+    double temps = (omp_get_wtime() - start) / repetitions;
+    free(dest);
+    return 2.0 * octets / temps * 1e-9;
+}
+
+static void afficher_debit(const char *nom, double temps, size_t octets,
+                           double debit_ref, int correct) {
+    double debit = octets / temps * 1e-9;
+    printf("   %-26s %12.6f s %10.2f GB/s %9.0f%% %s\n",
+           nom, temps, debit, 100.0 * debit / debit_ref, correct ? "✓" : "✗");
+}
+
+// Somme exacte de (i % 1000) + 1 pour i dans [0, size)
+static long long somme_motif(long size) {
+    long r = size % 1000;
+    return (size / 1000) * 500500LL + (long long)r * (r + 1) / 2;
+}
+
+// Tests des réductions vectorisées (GB/s lus, comparés à memcpy)
+void test_simd(long size) {
+    printf("\n==== RÉDUCTIONS SIMD: %ld éléments ====\n", size);
+    int repetitions = (int)((1L << 26) / size) + 1;
+
+    // --- int32 -> int64 (et float -> double dans le même tampon) ---
+    size_t octets = (size_t)size * sizeof(int);
+    int *arr = memoire_suffisante(octets) ? (int*)malloc(octets) : NULL;
+    if (!arr) {
+        printf("   ⚠️  Mémoire insuffisante (%.1f Go), test ignoré\n", octets / 1e9);
+        return;
+    }
+    #pragma omp parallel for num_threads(4)
+    for (long i = 0; i < size; i++) {
+        arr[i] = (int)(i + 1);
+    }
+    double ref = debit_memcpy(arr, octets);
+    printf("Référence memcpy (lecture + écriture): %.2f GB/s\n\n", ref);
+    printf("   %-26s %14s %15s %10s\n", "Noyau (4 threads)", "Temps", "Débit", "vs memcpy");
+
+    long long attendu_int = (long long)size * (size + 1) / 2;
+    long long s = 0;
+    double temps;
+    printf("   int32 -> int64 (%.1f Mo)\n", octets / 1e6);
+    MESURER(s, somme_reduction_int32(arr, size), repetitions, temps);
+    afficher_debit("reduction (baseline)", temps, octets, ref, s == attendu_int);
+    MESURER(s, somme_simd_int32(arr, size), repetitions, temps);
+    afficher_debit("simd reduction", temps, octets, ref, s == attendu_int);
+    MESURER(s, somme_accumulateurs_int32(arr, size), repetitions, temps);
+    afficher_debit("simd + 16 accumulateurs", temps, octets, ref, s == attendu_int);
+
+    float *arr_f = (float*)arr;
+    #pragma omp parallel for num_threads(4)
+    for (long i = 0; i < size; i++) {
+        arr_f[i] = (float)(i % 1000 + 1);
+    }
+    double attendu = (double)somme_motif(size);
+    double d = 0;
+    printf("   float -> double (%.1f Mo)\n", octets / 1e6);
+    MESURER(d, somme_reduction_float(arr_f, size), repetitions, temps);
+    afficher_debit("reduction", temps, octets, ref, d == attendu);
+    MESURER(d, somme_simd_float(arr_f, size), repetitions, temps);
+    afficher_debit("simd reduction", temps, octets, ref, d == attendu);
+    MESURER(d, somme_accumulateurs_float(arr_f, size), repetitions, temps);
+    afficher_debit("simd + 16 accumulateurs", temps, octets, ref, d == attendu);
+    free(arr);
+
+    // --- double -> double ---
+    octets = (size_t)size * sizeof(double);
+    double *arr_d = memoire_suffisante(octets) ? (double*)malloc(octets) : NULL;
+    if (!arr_d) {
+        printf("   double: ⚠️  mémoire insuffisante (%.1f Go), ignoré\n", octets / 1e9);
+        return;
+    }
+    #pragma omp parallel for num_threads(4)
+    for (long i = 0; i < size; i++) {
+        arr_d[i] = (double)(i % 1000 + 1);
+    }
+    printf("   double -> double (%.1f Mo)\n", octets / 1e6);
+    MESURER(d, somme_reduction_double(arr_d, size), repetitions, temps);
+    afficher_debit("reduction", temps, octets, ref, d == attendu);
+    MESURER(d, somme_simd_double(arr_d, size), repetitions, temps);
+    afficher_debit("simd reduction", temps, octets, ref, d == attendu);
+    MESURER(d, somme_accumulateurs_double(arr_d, size), repetitions, temps);
+    afficher_debit("simd + 16 accumulateurs", temps, octets, ref, d == attendu);
+    free(arr_d);
+}
+
+// Méthode 5: Réduction sur un fichier projeté en mémoire (mmap)
+/*
+ * test_size alloue le tableau en mémoire (int size: < 2^31 éléments).
+ * Pour sommer des colonnes int32/int64 de plusieurs centaines de Go, on
+ * projette le fichier avec mmap: le noyau charge les pages à la demande
+ * et la mémoire physique ne sert que de cache.
+ *
+ *   Fichier:  |====== T0 ======|====== T1 ======|====== T2 ======|...
+ *             tronçons de FICHIER_TRONCON octets dans chaque plage:
+ *             - MADV_SEQUENTIAL: lecture anticipée agressive
+ *             - MADV_WILLNEED sur le tronçon suivant (readahead)
+ *             - MADV_DONTNEED sur le tronçon traité: libère la projection
+ *               (les pages restent dans le cache du noyau)
+ *
+ * Chaque thread possède une plage contiguë: ses lectures restent
+ * séquentielles et la lecture anticipée du noyau fonctionne.
+ *
+ * Froid: posix_fadvise(DONTNEED) vide le cache du fichier -> débit disque
+ * Chaud: le fichier est déjà en cache -> débit mémoire (si fichier < RAM)
+ */
+#define FICHIER_TRONCON ((long)64 << 20)   // 64 Mo
+
+static long long somme_troncon_int32(const int32_t *a, long n) {
+    long long s = 0;
+    #pragma omp simd reduction(+:s)
+    for (long i = 0; i < n; i++) s += a[i];
+    return s;
+}
+
+static long long somme_troncon_int64(const int64_t *a, long n) {
+    long long s = 0;
+    #pragma omp simd reduction(+:s)
+    for (long i = 0; i < n; i++) s += a[i];
+    return s;
+}
+
+// Somme d'un fichier d'entiers (largeur = 4 ou 8 octets), retourne -1 si erreur
+int somme_fichier(const char *chemin, int largeur, int froid,
+                  long long *resultat, double *temps, long *octets) {
+    int fd = open(chemin, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "Erreur: Impossible d'ouvrir %s\n", chemin);
+        return -1;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < largeur) {
+        fprintf(stderr, "Erreur: Fichier vide ou illisible: %s\n", chemin);
+        close(fd);
+        return -1;
+    }
+    long n = st.st_size / largeur;
+    *octets = n * largeur;
+
+    // Cache froid: le noyau oublie les pages du fichier. DONTNEED ignore
+    // les pages sales: juste après generer, il faut d'abord les écrire
+    if (froid) {
+        fdatasync(fd);
+        posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    }
+
+    double start = omp_get_wtime();
+    const char *base = (const char*)mmap(NULL, *octets, PROT_READ, MAP_SHARED, fd, 0);
+    if (base == MAP_FAILED) {
+        fprintf(stderr, "Erreur: mmap impossible sur %s\n", chemin);
+        close(fd);
+        return -1;
+    }
+    madvise((void*)base, *octets, MADV_SEQUENTIAL);
+
+    long page = sysconf(_SC_PAGESIZE);
+    long par_troncon = FICHIER_TRONCON / largeur;
+    long long sum = 0;
+
+    #pragma omp parallel num_threads(4) reduction(+:sum)
+    {
+        int t = omp_get_thread_num();
+        int nb = omp_get_num_threads();
+        long debut = n * t / nb;
+        long fin = n * (t + 1) / nb;
+
+        for (long i = debut; i < fin; i += par_troncon) {
+            long taille = (i + par_troncon < fin) ? par_troncon : fin - i;
+            const char *troncon = base + i * largeur;
+
+            // Lecture anticipée du tronçon suivant pendant le calcul
+            if (i + taille < fin) {
+                long suivant = ((i + taille) * largeur) & ~(page - 1);
+                long longueur = ((fin < i + taille + par_troncon) ? fin : i + taille + par_troncon)
+                                * largeur - suivant;
+                madvise((void*)(base + suivant), longueur, MADV_WILLNEED);
+            }
+
+            if (largeur == 4) sum += somme_troncon_int32((const int32_t*)troncon, taille);
+            else              sum += somme_troncon_int64((const int64_t*)troncon, taille);
+
+            // Pages entièrement traitées: on libère la projection
+            long p_debut = (i * largeur + page - 1) & ~(page - 1);
+            long p_fin = ((i + taille) * largeur) & ~(page - 1);
+            if (p_fin > p_debut) {
+                madvise((void*)(base + p_debut), p_fin - p_debut, MADV_DONTNEED);
+            }
+        }
+    }
+
+    munmap((void*)base, *octets);
+    *temps = omp_get_wtime() - start;
+    close(fd);
+    *resultat = sum;
+    return 0;
+}
+
+// Génère un fichier de nb_elements entiers (i % 1000) + 1, retourne -1 si erreur
+int generer_fichier(const char *chemin, long nb_elements, int largeur) {
+    FILE *fp = fopen(chemin, "wb");
+    if (fp == NULL) {
+        fprintf(stderr, "Erreur: Impossible de créer %s\n", chemin);
+        return -1;
+    }
+    const long tampon_elements = 1 << 20;
+    char *tampon = (char*)malloc(tampon_elements * largeur);
+    if (tampon == NULL) {
+        fprintf(stderr, "Erreur: Allocation du tampon impossible\n");
+        fclose(fp);
+        return -1;
+    }
+    for (long i = 0; i < nb_elements; i += tampon_elements) {
+        long taille = (i + tampon_elements < nb_elements) ? tampon_elements : nb_elements - i;
+        for (long k = 0; k < taille; k++) {
+            long v = (i + k) % 1000 + 1;
+            if (largeur == 4) ((int32_t*)tampon)[k] = (int32_t)v;
+            else              ((int64_t*)tampon)[k] = (int64_t)v;
+        }
+        if (fwrite(tampon, largeur, taille, fp) != (size_t)taille) {
+            fprintf(stderr, "Erreur: Écriture impossible dans %s (disque plein?)\n", chemin);
+            free(tampon);
+            fclose(fp);
+            return -1;
+        }
+    }
+    free(tampon);
+    fclose(fp);
+    printf("Fichier généré: %s (%ld éléments int%d, %.2f Go)\n",
+           chemin, nb_elements, largeur * 8, (double)nb_elements * largeur / 1e9);
+    return 0;
+}
+
+// Mesure froid puis chaud; vérifie la somme si le fichier vient de generer_fichier
+int test_fichier(const char *chemin, int largeur) {
+    printf("\n==== RÉDUCTION SUR FICHIER (mmap, int%d): %s ====\n", largeur * 8, chemin);
+    long long s;
+    double temps;
+    long octets;
+    for (int froid = 1; froid >= 0; froid--) {
+        if (somme_fichier(chemin, largeur, froid, &s, &temps, &octets) != 0) return -1;
+        long n = octets / largeur;
+        printf("   %-6s %12.4f s %10.2f GB/s   somme = %lld %s\n",
+               froid ? "Froid" : "Chaud", temps, octets / temps * 1e-9, s,
+               (s == somme_motif(n)) ? "✓" : "(motif inconnu)");
+    }
+    long ram = sysconf(_SC_PHYS_PAGES) * sysconf(_SC_PAGESIZE);
+    if (octets > ram) {
+        printf("   Fichier (%.1f Go) > RAM (%.1f Go): le cache ne peut pas tout garder,\n",
+               octets / 1e9, ram / 1e9);
+        printf("   la mesure \"chaud\" reste proche du débit disque\n");
+    }
+    return 0;
+}
+
 // Démonstration visuelle du principe de reduction
 void demo_reduction_visuelle() {
     printf("\n==== DÉMONSTRATION VISUELLE DE REDUCTION ====\n\n");
@@ -281,7 +643,25 @@ void demo_critical_visuelle() {
     printf("Note: Un seul thread à la fois dans la section critique → le plus lent!\n");
 }
 
-int main() {
+int main(int argc, char *argv[]) {
+    // Modes fichier:
+    //   ./lab2 generer <fichier> <nb_elements> [int32|int64]
+    //   ./lab2 fichier <fichier> [int32|int64]
+    if (argc > 2 && (strcmp(argv[1], "generer") == 0 || strcmp(argv[1], "fichier") == 0)) {
+        int generer = (strcmp(argv[1], "generer") == 0);
+        const char *type = (argc > 3 + generer) ? argv[3 + generer] : "int32";
+        int largeur = (strcmp(type, "int64") == 0) ? 8 : 4;
+        if (generer) {
+            if (argc < 4) {
+                fprintf(stderr, "Erreur: Usage: %s generer <fichier> <nb_elements> [int32|int64]\n", argv[0]);
+                return 1;
+            }
+            long nb = (long)strtod(argv[3], NULL);
+            return generer_fichier(argv[2], nb, largeur) == 0 ? 0 : 1;
+        }
+        return test_fichier(argv[2], largeur) == 0 ? 0 : 1;
+    }
+
     printf("==== LAB 2: Somme de tableau avec OpenMP ====\n");
     printf("Comparaison: REDUCTION vs ATOMIC vs CRITICAL\n");
     printf("Nombre de threads: 4\n");
@@ -301,6 +681,15 @@ int main() {
     test_size(100000);      // Moyen tableau
     test_size(10000000);    // Grand tableau
     
+    printf("\n");
+    printf("========================================\n");
+    printf("RÉDUCTIONS VECTORISÉES (SIMD)\n");
+    printf("========================================\n");
+    test_simd(1000);
+    test_simd(100000);
+    test_simd(10000000);
+    test_simd(1000000000);  // 4 Go (int32/float), 8 Go (double)
+    
     printf("\n==== CONCLUSION ====\n");
     printf("✅ REDUCTION: Le plus rapide et le plus simple\n");
     printf("   - OpenMP optimise automatiquement\n");
@@ -315,7 +704,16 @@ int main() {
     printf("❌ CRITICAL: Le plus lent\n");
     printf("   - Sérialise complètement les accès\n");
     printf("   - Un seul thread à la fois dans la section\n");
-    printf("   - À ÉVITER pour ce type de calcul\n");
+    printf("   - À ÉVITER pour ce type de calcul\n\n");
+    
+    printf("🚀 SIMD: reduction + vectorisation\n");
+    printf("   - omp simd autorise le réordonnancement des additions (flottants)\n");
+    printf("   - Plusieurs accumulateurs cassent la chaîne de dépendance\n");
+    printf("   - Grands tableaux: limité par la bande passante mémoire (cf. memcpy)\n\n");
+
+    printf("💾 FICHIER (mmap): ./lab2 fichier <chemin> [int32|int64]\n");
+    printf("   - Une plage contiguë par thread, lecture anticipée par tronçons\n");
+    printf("   - Pas de limite de RAM: froid = débit disque, chaud = débit mémoire\n");
     
     return 0;
 }
@@ -9,12 +9,24 @@
  * 2. Parallèle avec reduction
  * 3. Parallèle avec schedule(static)
  * 4. Parallèle avec schedule(dynamic)
+ * 5-8. Ordonnanceurs personnalisés (ordonnanceur.h):
+ *      factoring, trapezoid (TSS), statique pondéré par coût, adaptatif
+ * 9. Crible d'Ératosthène segmenté parallèle (crible.h), jusqu'à 1e10 et plus
+ * 10. Crible segmenté avec roue mod 30 bit-packée (8 bits pour 30 nombres)
+ * 11. Comptage sous-linéaire pi(x) (Lucy_Hedgehog), sans énumérer les premiers
+ *
+ * Usage: ./lab3                 tests complets
+ *        ./lab3 --crible N      crible segmenté seul jusqu'à N (ex: 1e10)
+ *        ./lab3 --pi X          pi(X) par Lucy_Hedgehog (ex: 1e12, 1e14)
  */
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <omp.h>
 #include <math.h>
+#include <string.h>
+#include "ordonnanceur.h"
+#include "crible.h"
 
 // Fonction pour vérifier si un nombre est premier
 int est_premier(int n) {
@@ -79,6 +91,38 @@ int count_primes_parallel_dynamic(int n, int num_threads) {
     return count;
 }
 
+// Modèle de coût de est_premier(i): ~sqrt(i)/2 divisions pour un impair, 1 sinon
+double cout_test_premier(long i, void *ctx) {
+    (void)ctx;
+    if (i < 3 || i % 2 == 0) return 1.0;
+    return 1.0 + 0.5 * sqrt((double)i);
+}
+
+// Méthodes 5-8: PARALLÈLE avec un ORDONNANCEUR PERSONNALISÉ
+int count_primes_parallel_ordo(int n, int num_threads, TypeOrdo type) {
+    int count = 0;
+    Ordonnanceur ordo;
+    ordo_init(&ordo, type, 2, (long)n + 1, num_threads, 16,
+              cout_test_premier, NULL);
+    
+    #pragma omp parallel reduction(+:count) num_threads(num_threads)
+    {
+        OrdoEtatThread etat;
+        ordo_etat_init(&etat);
+        long debut, fin;
+        while (ordo_prochain(&ordo, &etat, &debut, &fin)) {
+            for (long i = debut; i < fin; i++) {
+                if (est_premier((int)i)) {
+                    count++;
+                }
+            }
+        }
+    }
+    
+    ordo_liberer(&ordo);
+    return count;
+}
+
 // Fonction pour afficher les premiers nombres premiers (pour petits N)
 void afficher_premiers(int n) {
     printf("Nombres premiers jusqu'à %d: ", n);
@@ -111,7 +155,8 @@ void test_performance(int n, int num_threads) {
     double time_seq = end - start;
     printf("1. SÉQUENTIEL:\n");
     printf("   Nombres premiers trouvés: %d\n", result);
-    printf("   Temps: %.6f secondes\n\n", time_seq);
+    printf("   Temps: %.6f secondes\n", time_seq);
+    printf("   Débit: %.2f M nombres/s\n\n", n / time_seq * 1e-6);
     
     // 2. PARALLÈLE avec REDUCTION (schedule par défaut)
     start = omp_get_wtime();
@@ -120,7 +165,8 @@ void test_performance(int n, int num_threads) {
     double time_red = end - start;
     printf("2. PARALLÈLE (reduction, schedule par défaut):\n");
     printf("   Nombres premiers trouvés: %d\n", result);
-    printf("   Temps: %.6f secondes\n\n", time_red);
+    printf("   Temps: %.6f secondes\n", time_red);
+    printf("   Débit: %.2f M nombres/s\n\n", n / time_red * 1e-6);
     
     // 3. PARALLÈLE avec SCHEDULE STATIC
     start = omp_get_wtime();
@@ -129,7 +175,8 @@ void test_performance(int n, int num_threads) {
     double time_static = end - start;
     printf("3. PARALLÈLE (schedule static):\n");
     printf("   Nombres premiers trouvés: %d\n", result);
-    printf("   Temps: %.6f secondes\n\n", time_static);
+    printf("   Temps: %.6f secondes\n", time_static);
+    printf("   Débit: %.2f M nombres/s\n\n", n / time_static * 1e-6);
     
     // 4. PARALLÈLE avec SCHEDULE DYNAMIC
     start = omp_get_wtime();
@@ -138,7 +185,42 @@ void test_performance(int n, int num_threads) {
     double time_dyn = end - start;
     printf("4. PARALLÈLE (schedule dynamic, chunk=100):\n");
     printf("   Nombres premiers trouvés: %d\n", result);
-    printf("   Temps: %.6f secondes\n\n", time_dyn);
+    printf("   Temps: %.6f secondes\n", time_dyn);
+    printf("   Débit: %.2f M nombres/s\n\n", n / time_dyn * 1e-6);
+    
+    // 5-8. PARALLÈLE avec ORDONNANCEURS PERSONNALISÉS
+    double time_ordo[ORDO_NB_TYPES];
+    for (int t = 0; t < ORDO_NB_TYPES; t++) {
+        start = omp_get_wtime();
+        result = count_primes_parallel_ordo(n, num_threads, (TypeOrdo)t);
+        end = omp_get_wtime();
+        time_ordo[t] = end - start;
+        printf("%d. PARALLÈLE (ordonnanceur %s):\n", 5 + t, ordo_noms[t]);
+        printf("   Nombres premiers trouvés: %d\n", result);
+        printf("   Temps: %.6f secondes\n", time_ordo[t]);
+        printf("   Débit: %.2f M nombres/s\n\n", n / time_ordo[t] * 1e-6);
+    }
+    
+    // 9. CRIBLE SEGMENTÉ PARALLÈLE
+    start = omp_get_wtime();
+    result = (int)count_primes_crible_segmente((uint64_t)n, num_threads);
+    end = omp_get_wtime();
+    double time_crible = end - start;
+    printf("9. CRIBLE SEGMENTÉ PARALLÈLE (segments de %d Ko, schedule dynamic):\n",
+           CRIBLE_SEGMENT_OCTETS / 1024);
+    printf("   Nombres premiers trouvés: %d\n", result);
+    printf("   Temps: %.6f secondes\n", time_crible);
+    printf("   Débit: %.2f M nombres/s\n\n", n / time_crible * 1e-6);
+    
+    // 10. CRIBLE ROUE MOD 30
+    start = omp_get_wtime();
+    result = (int)count_primes_crible_roue((uint64_t)n, num_threads);
+    end = omp_get_wtime();
+    double time_roue = end - start;
+    printf("10. CRIBLE ROUE MOD 30 (pré-criblage 7-17 par motif):\n");
+    printf("   Nombres premiers trouvés: %d\n", result);
+    printf("   Temps: %.6f secondes\n", time_roue);
+    printf("   Débit: %.2f M nombres/s\n\n", n / time_roue * 1e-6);
     
     // Comparaison
     printf("COMPARAISON:\n");
@@ -146,6 +228,11 @@ void test_performance(int n, int num_threads) {
     printf("   REDUCTION:         %.6f s\n", time_red);
     printf("   SCHEDULE STATIC:   %.6f s\n", time_static);
     printf("   SCHEDULE DYNAMIC:  %.6f s\n", time_dyn);
+    for (int t = 0; t < ORDO_NB_TYPES; t++) {
+        printf("   ORDO %-13s %.6f s\n", ordo_noms[t], time_ordo[t]);
+    }
+    printf("   CRIBLE SEGMENTÉ:   %.6f s\n", time_crible);
+    printf("   CRIBLE ROUE 30:    %.6f s\n", time_roue);
     
     // Meilleure méthode
     double best_time = time_red;
@@ -158,12 +245,194 @@ void test_performance(int n, int num_threads) {
         best_time = time_dyn;
         best_method = "SCHEDULE DYNAMIC";
     }
+    for (int t = 0; t < ORDO_NB_TYPES; t++) {
+        if (time_ordo[t] < best_time) {
+            best_time = time_ordo[t];
+            best_method = ordo_noms[t];
+        }
+    }
+    if (time_crible < best_time) {
+        best_time = time_crible;
+        best_method = "CRIBLE SEGMENTÉ";
+    }
+    if (time_roue < best_time) {
+        best_time = time_roue;
+        best_method = "CRIBLE ROUE 30";
+    }
     printf("   Meilleure méthode: %s (%.6f s)\n", 
            best_method, best_time);
     
     printf("\n========================================\n\n");
 }
 
+// Méthode 11: COMPTAGE SOUS-LINÉAIRE (Lucy_Hedgehog)
+/*
+ * S(v) = nombre d'entiers de [2, v] qui survivent au crible par les premiers < p.
+ * Seules les valeurs v = x/k sont nécessaires (~2 sqrt(x) valeurs):
+ *   petites[v] = S(v)     pour v <= sqrt(x)
+ *   grandes[k] = S(x/k)   pour x/k > sqrt(x)
+ * Pour chaque premier p <= sqrt(x), pour tout v >= p²:
+ *   S(v) -= S(v/p) - S(p-1)
+ * À la fin, S(x) = pi(x). Temps O(x^(3/4)), mémoire O(sqrt(x)).
+ *
+ * Parallélisation: pour un p donné, les S(v/p) lus sont les anciennes
+ * valeurs; on calcule donc d'abord tous les deltas (lecture seule, en
+ * parallèle), puis on les applique (écriture seule, en parallèle).
+ * Les grands p ont trop peu de travail: ils restent séquentiels (clause if).
+ */
+#define LUCY_SEUIL_PARALLELE 20000
+
+uint64_t count_primes_lucy(uint64_t x, int num_threads) {
+    if (x < 2) return 0;
+    uint64_t r = crible_isqrt(x);
+    
+    // Nombre de k tels que x/k > r
+    uint64_t nb_grandes = x / (r + 1);
+    if (nb_grandes > r) nb_grandes = r;
+    
+    int64_t *petites = (int64_t*)malloc((r + 1) * sizeof(int64_t));
+    int64_t *grandes = (int64_t*)malloc((nb_grandes + 1) * sizeof(int64_t));
+    int64_t *delta = (int64_t*)malloc((r + 1) * sizeof(int64_t));
+    
+    #pragma omp parallel for schedule(static) num_threads(num_threads)
+    for (uint64_t v = 0; v <= r; v++) {
+        petites[v] = (v >= 1) ? (int64_t)v - 1 : 0;
+    }
+    #pragma omp parallel for schedule(static) num_threads(num_threads)
+    for (uint64_t k = 1; k <= nb_grandes; k++) {
+        grandes[k] = (int64_t)(x / k) - 1;
+    }
+    
+    for (uint64_t p = 2; p <= r; p++) {
+        if (petites[p] == petites[p - 1]) continue;  // p n'est pas premier
+        int64_t sp = petites[p - 1];
+        uint64_t p2 = p * p;
+        
+        // Grandes valeurs: k tel que x/k >= p²
+        uint64_t kmax = x / p2;
+        if (kmax > nb_grandes) kmax = nb_grandes;
+        
+        #pragma omp parallel for schedule(static) num_threads(num_threads) \
+                if(kmax > LUCY_SEUIL_PARALLELE)
+        for (uint64_t k = 1; k <= kmax; k++) {
+            uint64_t kp = k * p;
+            int64_t s = (kp <= nb_grandes) ? grandes[kp] : petites[x / kp];
+            delta[k] = s - sp;
+        }
+        #pragma omp parallel for schedule(static) num_threads(num_threads) \
+                if(kmax > LUCY_SEUIL_PARALLELE)
+        for (uint64_t k = 1; k <= kmax; k++) {
+            grandes[k] -= delta[k];
+        }
+        
+        // Petites valeurs: v dans [p², r]
+        if (p2 <= r) {
+            #pragma omp parallel for schedule(static) num_threads(num_threads) \
+                    if(r - p2 > LUCY_SEUIL_PARALLELE)
+            for (uint64_t v = p2; v <= r; v++) {
+                delta[v] = petites[v / p] - sp;
+            }
+            #pragma omp parallel for schedule(static) num_threads(num_threads) \
+                    if(r - p2 > LUCY_SEUIL_PARALLELE)
+            for (uint64_t v = p2; v <= r; v++) {
+                petites[v] -= delta[v];
+            }
+        }
+    }
+    
+    uint64_t resultat = (uint64_t)((nb_grandes >= 1) ? grandes[1] : petites[x]);
+    free(petites);
+    free(grandes);
+    free(delta);
+    return resultat;
+}
+
+// Validation et scaling du comptage sous-linéaire
+void test_lucy(uint64_t x_max) {
+    printf("==== COMPTAGE SOUS-LINÉAIRE pi(x) (Lucy_Hedgehog) ====\n");
+    
+    // Validation contre la division (petits N) et le crible (N moyens)
+    int ok = 1;
+    int petits_n[] = {10, 100, 1000, 10000, 100000};
+    for (int i = 0; i < 5; i++) {
+        uint64_t a = count_primes_lucy((uint64_t)petits_n[i], 4);
+        uint64_t b = (uint64_t)count_primes_sequential(petits_n[i]);
+        if (a != b) ok = 0;
+        printf("   pi(%d): Lucy = %llu | séquentiel = %llu %s\n", petits_n[i],
+               (unsigned long long)a, (unsigned long long)b, (a == b) ? "✓" : "✗");
+    }
+    uint64_t moyens_n[] = {999983ULL, 10000000ULL, 123456789ULL, 1000000000ULL};
+    for (int i = 0; i < 4; i++) {
+        uint64_t a = count_primes_lucy(moyens_n[i], 4);
+        uint64_t b = count_primes_crible_roue(moyens_n[i], 4);
+        if (a != b) ok = 0;
+        printf("   pi(%llu): Lucy = %llu | crible = %llu %s\n",
+               (unsigned long long)moyens_n[i], (unsigned long long)a,
+               (unsigned long long)b, (a == b) ? "✓" : "✗");
+    }
+    printf("   %s\n\n", ok ? "✓ Validation réussie" : "✗ ERREUR de validation!");
+    
+    // Scaling avec le nombre de threads
+    int thread_counts[] = {1, 2, 4, 8};
+    for (uint64_t x = 10000000000ULL; x <= x_max; x *= 10) {
+        printf("   x = %.0e (mémoire ~%.1f Mo):\n", (double)x,
+               3.0 * crible_isqrt(x) * sizeof(int64_t) * 1e-6);
+        double time_1 = 0.0;
+        for (int t = 0; t < 4; t++) {
+            double start = omp_get_wtime();
+            uint64_t pi = count_primes_lucy(x, thread_counts[t]);
+            double temps = omp_get_wtime() - start;
+            if (t == 0) time_1 = temps;
+            printf("      Threads: %d | pi(x) = %llu | Temps: %.4f s | Speedup: %.2fx\n",
+                   thread_counts[t], (unsigned long long)pi, temps, time_1 / temps);
+        }
+    }
+    printf("\n");
+}
+
+// Crible segmenté seul pour les grands N (trial division impossible)
+void test_crible_grand(uint64_t n) {
+    printf("==== CRIBLE SEGMENTÉ: N = %llu ====\n", (unsigned long long)n);
+    
+    int thread_counts[] = {1, 2, 4, 8};
+    double time_1 = 0.0;
+    for (int t = 0; t < 4; t++) {
+        double start = omp_get_wtime();
+        uint64_t result = count_primes_crible_roue(n, thread_counts[t]);
+        double temps = omp_get_wtime() - start;
+        if (t == 0) time_1 = temps;
+        printf("   Threads: %d | pi(N) = %llu | Temps: %.4f s | "
+               "Débit: %.1f M nombres/s | Speedup: %.2fx\n",
+               thread_counts[t], (unsigned long long)result, temps,
+               n / temps * 1e-6, time_1 / temps);
+    }
+    
+    // Comparaison des représentations (même nombre de threads)
+    int threads = omp_get_max_threads();
+    printf("\n   Représentation (%d threads, segments de %d Ko):\n",
+           threads, CRIBLE_SEGMENT_OCTETS / 1024);
+    printf("   %-22s %10s %12s %12s %10s %10s\n", "", "Octets/nb", "Nombres/seg",
+           "Balayé (Mo)", "Économie", "Temps (s)");
+    
+    const char *noms[3] = {"Octets (1 par nombre)", "Impairs (1 bit)", "Roue mod 30"};
+    double octets_par_nombre[3] = {1.0, 1.0 / 16.0, 1.0 / 30.0};
+    uint64_t resultats[3] = {0, 0, 0};
+    for (int r = 0; r < 3; r++) {
+        double start = omp_get_wtime();
+        if (r == 0) resultats[r] = count_primes_crible_octets(n, threads);
+        else if (r == 1) resultats[r] = count_primes_crible_segmente(n, threads);
+        else resultats[r] = count_primes_crible_roue(n, threads);
+        double temps = omp_get_wtime() - start;
+        double octets = n * octets_par_nombre[r];
+        printf("   %-22s %10.4f %12.0f %12.1f %9.1f%% %10.4f\n", noms[r],
+               octets_par_nombre[r], CRIBLE_SEGMENT_OCTETS / octets_par_nombre[r],
+               octets * 1e-6, 100.0 * (1.0 - octets_par_nombre[r]), temps);
+    }
+    printf("   %s Mémoire par nombre: roue = 1/30 des octets, 1/1.9 des bits impairs\n",
+           (resultats[0] == resultats[1] && resultats[1] == resultats[2]) ? "✓" : "✗ ERREUR:");
+    printf("\n");
+}
+
 // Démonstration visuelle: distribution du travail entre threads
 void demo_distribution_travail() {
     printf("==== DÉMONSTRATION: Distribution du travail ====\n\n");
@@ -207,7 +476,18 @@ void demo_distribution_travail() {
     printf("========================================\n\n");
 }
 
-int main() {
+int main(int argc, char *argv[]) {
+    // Mode crible seul: ./lab3 --crible N
+    if (argc > 2 && strcmp(argv[1], "--crible") == 0) {
+        test_crible_grand((uint64_t)strtod(argv[2], NULL));
+        return 0;
+    }
+    // Mode comptage seul: ./lab3 --pi X
+    if (argc > 2 && strcmp(argv[1], "--pi") == 0) {
+        test_lucy((uint64_t)strtod(argv[2], NULL));
+        return 0;
+    }
+    
     printf("==== LAB 3: Nombres Premiers avec OpenMP ====\n");
     printf("Comparaison: SÉQUENTIEL vs PARALLÈLE\n");
     
@@ -226,6 +506,15 @@ int main() {
         test_performance(sizes[i], num_threads);
     }
     
+    // Grands N: seul le crible segmenté est raisonnable
+    uint64_t grands_n[] = {10000000ULL, 100000000ULL, 1000000000ULL};
+    for (int i = 0; i < 3; i++) {
+        test_crible_grand(grands_n[i]);
+    }
+    
+    // Quand seul pi(x) compte: Lucy_Hedgehog, sans énumérer les premiers
+    test_lucy(100000000000ULL);
+    
     printf("\n==== EXPLICATION DES SCHEDULES ====\n\n");
     printf("1. SCHEDULE(STATIC):\n");
     printf("   - Divise les itérations en blocs égaux au démarrage\n");
@@ -247,7 +536,24 @@ int main() {
     printf("POUR LES NOMBRES PREMIERS:\n");
     printf("- Les petits nombres sont rapides à tester\n");
     printf("- Les grands nombres prennent plus de temps (plus de divisions)\n");
-    printf("- DYNAMIC peut être meilleur car il équilibre mieux la charge\n");
+    printf("- DYNAMIC peut être meilleur car il équilibre mieux la charge\n\n");
+    
+    printf("ORDONNANCEURS PERSONNALISÉS (ordonnanceur.h):\n");
+    printf("- FACTORING: lots de P chunks, chaque lot = moitié du reste\n");
+    printf("- TSS: chunks décroissant linéairement de N/2P à chunk_min\n");
+    printf("- PONDÉRÉ: partition statique équilibrée selon le coût sqrt(i)\n");
+    printf("- ADAPTATIF: chunk ajusté au débit mesuré de chaque thread\n\n");
+    
+    printf("CRIBLE SEGMENTÉ (crible.h):\n");
+    printf("- O(N log log N) au lieu de O(N sqrt(N)) pour la division\n");
+    printf("- Segments de la taille du cache L1, distribués dynamiquement\n");
+    printf("- 1 bit par impair, comptage par popcount\n");
+    printf("- ROUE MOD 30: 8 bits pour 30 nombres, 30x moins de mémoire qu'un\n");
+    printf("  tableau d'octets; les multiples de 7 à 17 sont pré-criblés par copie\n\n");
+    
+    printf("COMPTAGE SOUS-LINÉAIRE (Lucy_Hedgehog):\n");
+    printf("- pi(x) sans énumérer les premiers: O(x^(3/4)) temps, O(sqrt(x)) mémoire\n");
+    printf("- pi(1e12) en quelques secondes là où le crible balaie 1e12 nombres\n");
     
     return 0;
 }
@@ -5,6 +5,8 @@
  * - Tailles: 128, 256, 512, 1024, 2048
  * - Nombre de threads: 1, 2, 4, 8, 16
  * - Schedules: static vs dynamic avec différents chunk sizes
+ * - Ordonnanceurs personnalisés (../ordonnanceur.h): factoring, tss,
+ *   pondere, adaptatif
  * - Calcul de speedup et efficacité
  * 
  * Méthode optimisée:ijk avec cache-friendly access pattern
@@ -15,6 +17,7 @@
 #include <omp.h>
 #include <string.h>
 #include <math.h>
+#include "matrix.h"
 
 // Structure pour stocker les résultats de performance
 typedef struct {
@@ -53,63 +56,6 @@ void init_matrix(double** matrix, int n) {
     }
 }
 
-// Multiplication séquentielle (pour référence)
-void matrix_mult_sequential(double** A, double** B, double** C, int n) {
-    for (int i = 0; i < n; i++) {
-        for (int j = 0; j < n; j++) {
-            C[i][j] = 0.0;
-            for (int k = 0; k < n; k++) {
-                C[i][j] += A[i][k] * B[k][j];
-            }
-        }
-    }
-}
-
-// Multiplication parallèle avec schedule static
-void matrix_mult_parallel_static(double** A, double** B, double** C, int n, 
-                                  int num_threads, int chunk_size) {
-    #pragma omp parallel for schedule(static, chunk_size) num_threads(num_threads)
-    for (int i = 0; i < n; i++) {
-        for (int j = 0; j < n; j++) {
-            double sum = 0.0;
-            for (int k = 0; k < n; k++) {
-                sum += A[i][k] * B[k][j];
-            }
-            C[i][j] = sum;
-        }
-    }
-}
-
-// Multiplication parallèle avec schedule dynamic
-void matrix_mult_parallel_dynamic(double** A, double** B, double** C, int n, 
-                                   int num_threads, int chunk_size) {
-    #pragma omp parallel for schedule(dynamic, chunk_size) num_threads(num_threads)
-    for (int i = 0; i < n; i++) {
-        for (int j = 0; j < n; j++) {
-            double sum = 0.0;
-            for (int k = 0; k < n; k++) {
-                sum += A[i][k] * B[k][j];
-            }
-            C[i][j] = sum;
-        }
-    }
-}
-
-// Multiplication parallèle avec schedule guided
-void matrix_mult_parallel_guided(double** A, double** B, double** C, int n, 
-                                  int num_threads, int chunk_size) {
-    #pragma omp parallel for schedule(guided, chunk_size) num_threads(num_threads)
-    for (int i = 0; i < n; i++) {
-        for (int j = 0; j < n; j++) {
-            double sum = 0.0;
-            for (int k = 0; k < n; k++) {
-                sum += A[i][k] * B[k][j];
-            }
-            C[i][j] = sum;
-        }
-    }
-}
-
 // Vérifier si deux matrices sont égales (pour validation)
 int verify_result(double** C1, double** C2, int n) {
     double epsilon = 1e-6;
@@ -150,6 +96,13 @@ PerformanceResult benchmark_configuration(double** A, double** B, double** C,
         matrix_mult_parallel_dynamic(A, B, C, n, num_threads, chunk_size);
     } else if (strcmp(schedule_type, "guided") == 0) {
         matrix_mult_parallel_guided(A, B, C, n, num_threads, chunk_size);
+    } else {
+        for (int t = 0; t < ORDO_NB_TYPES; t++) {
+            if (strcmp(schedule_type, ordo_noms[t]) == 0) {
+                matrix_mult_parallel_ordo(A, B, C, n, num_threads, chunk_size,
+                                          (TypeOrdo)t);
+            }
+        }
     }
     
     double end = omp_get_wtime();
@@ -237,6 +190,20 @@ void test_matrix_size(int n) {
         print_result(result);
     }
     
+    printf("\n");
+    printf("--------------------------------------------------------------------------------\n");
+    printf("ORDONNANCEURS PERSONNALISÉS (8 threads, chunk min=4)\n");
+    printf("--------------------------------------------------------------------------------\n");
+    
+    for (int t = 0; t < ORDO_NB_TYPES; t++) {
+        PerformanceResult result = benchmark_configuration(A, B, C, n, 8, 
+                                                          ordo_noms[t], 4, seq_time);
+        print_result(result);
+        if (!verify_result(C, C_ref, n)) {
+            printf("✗ ERREUR: Résultat incorrect avec %s!\n", ordo_noms[t]);
+        }
+    }
+    
     printf("\n");
     printf("--------------------------------------------------------------------------------\n");
     printf("MEILLEURE CONFIGURATION TROUVÉE\n");
@@ -455,7 +422,9 @@ int main(int argc, char* argv[]) {
     printf("4. COMPARAISON DES SCHEDULES:\n");
     printf("   - STATIC: Meilleur pour matrices (charge uniforme)\n");
     printf("   - DYNAMIC: Plus d'overhead, pas d'avantage pour matrices\n");
-    printf("   - GUIDED: Compromis, utile pour charges variables\n\n");
+    printf("   - GUIDED: Compromis, utile pour charges variables\n");
+    printf("   - FACTORING/TSS/ADAPTATIF: chunks décroissants sans lock, peu\n");
+    printf("     d'intérêt pour une charge uniforme mais robustes si elle varie\n\n");
     
     printf("5. SCALING BEHAVIOR:\n");
     printf("   - Le scaling est sous-linéaire (attendu pour multiplication de matrices)\n");
@@ -0,0 +1,110 @@
+/*
+ * MATRIX: Noyaux de multiplication de matrices (matrix.c)
+ *
+ * Bibliothèque "header-only": les noyaux mesurés par matrix.c, partagés
+ * avec les benchmarks de Labs/ (bench_progression.c). Matrices n x n
+ * allouées ligne par ligne (double**), parallélisme sur les lignes de C.
+ */
+
+#ifndef MATRIX_H
+#define MATRIX_H
+
+#include <stddef.h>
+#include <omp.h>
+#include "../ordonnanceur.h"
+
+// Multiplication séquentielle (pour référence)
+static inline void matrix_mult_sequential(double** A, double** B, double** C, int n) {
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            C[i][j] = 0.0;
+            for (int k = 0; k < n; k++) {
+                C[i][j] += A[i][k] * B[k][j];
+            }
+        }
+    }
+}
+
+// Multiplication parallèle avec schedule static; avancer (optionnel, NULL
+// sinon) est appelé après chaque ligne de C, cf. progression_rappel
+static inline void matrix_mult_parallel_static_suivi(double** A, double** B, double** C, int n,
+                                                     int num_threads, int chunk_size,
+                                                     void (*avancer)(void*, int, long), void *arg) {
+    #pragma omp parallel for schedule(static, chunk_size) num_threads(num_threads)
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            double sum = 0.0;
+            for (int k = 0; k < n; k++) {
+                sum += A[i][k] * B[k][j];
+            }
+            C[i][j] = sum;
+        }
+        if (avancer != NULL) avancer(arg, omp_get_thread_num(), 1);
+    }
+}
+
+// Multiplication parallèle avec schedule static
+static inline void matrix_mult_parallel_static(double** A, double** B, double** C, int n, 
+                                               int num_threads, int chunk_size) {
+    matrix_mult_parallel_static_suivi(A, B, C, n, num_threads, chunk_size, NULL, NULL);
+}
+
+// Multiplication parallèle avec schedule dynamic
+static inline void matrix_mult_parallel_dynamic(double** A, double** B, double** C, int n, 
+                                                int num_threads, int chunk_size) {
+    #pragma omp parallel for schedule(dynamic, chunk_size) num_threads(num_threads)
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            double sum = 0.0;
+            for (int k = 0; k < n; k++) {
+                sum += A[i][k] * B[k][j];
+            }
+            C[i][j] = sum;
+        }
+    }
+}
+
+// Multiplication parallèle avec schedule guided
+static inline void matrix_mult_parallel_guided(double** A, double** B, double** C, int n, 
+                                               int num_threads, int chunk_size) {
+    #pragma omp parallel for schedule(guided, chunk_size) num_threads(num_threads)
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            double sum = 0.0;
+            for (int k = 0; k < n; k++) {
+                sum += A[i][k] * B[k][j];
+            }
+            C[i][j] = sum;
+        }
+    }
+}
+
+// Multiplication parallèle avec un ordonnanceur personnalisé (lignes = itérations)
+static inline void matrix_mult_parallel_ordo(double** A, double** B, double** C, int n, 
+                                             int num_threads, int chunk_size, TypeOrdo type) {
+    Ordonnanceur ordo;
+    // Coût uniforme par ligne: la partition pondérée est équivalente à static
+    ordo_init(&ordo, type, 0, n, num_threads, chunk_size, NULL, NULL);
+    
+    #pragma omp parallel num_threads(num_threads)
+    {
+        OrdoEtatThread etat;
+        ordo_etat_init(&etat);
+        long debut, fin;
+        while (ordo_prochain(&ordo, &etat, &debut, &fin)) {
+            for (long i = debut; i < fin; i++) {
+                for (int j = 0; j < n; j++) {
+                    double sum = 0.0;
+                    for (int k = 0; k < n; k++) {
+                        sum += A[i][k] * B[k][j];
+                    }
+                    C[i][j] = sum;
+                }
+            }
+        }
+    }
+    
+    ordo_liberer(&ordo);
+}
+
+#endif
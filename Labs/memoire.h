@@ -0,0 +1,32 @@
+/*
+ * MEMOIRE: Vérifier la mémoire libre avant une grosse allocation
+ *
+ * Bibliothèque "header-only". Sous Linux, malloc réussit au-delà de la
+ * mémoire physique disponible (overcommit): l'échec n'arrive qu'au premier
+ * contact, et c'est l'OOM killer qui arrête le programme au lieu d'un
+ * NULL que l'on pourrait traiter. Les tests de plusieurs Go comparent donc
+ * la taille demandée à la mémoire libre, avec une marge.
+ *
+ * Utilisation:
+ *
+ *   double *a = memoire_suffisante(octets) ? (double*)malloc(octets) : NULL;
+ *   if (a == NULL) { ... mémoire insuffisante ... }
+ */
+
+#ifndef MEMOIRE_H
+#define MEMOIRE_H
+
+#include <stddef.h>
+#include <unistd.h>
+
+// Mémoire physique libre (octets), hors cache de pages
+static inline size_t memoire_libre(void) {
+    return (size_t)sysconf(_SC_AVPHYS_PAGES) * (size_t)sysconf(_SC_PAGESIZE);
+}
+
+// Au plus 80% de la mémoire libre: le reste pour le système et les tampons
+static inline int memoire_suffisante(size_t octets) {
+    return octets <= memoire_libre() / 10 * 8;
+}
+
+#endif
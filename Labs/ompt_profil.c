@@ -0,0 +1,405 @@
+/*
+ * OMPT PROFIL: Outil de profilage chargé par l'interface OpenMP Tools
+ *
+ * Objectif: Savoir où passe le temps dans le runtime SANS modifier les labs
+ *
+ * Mesures (par construction, identifiée par son adresse de retour):
+ * 1. Durée des régions parallèles
+ * 2. Durée des boucles (worksharing) et autres constructions de partage
+ * 3. Attente dans les barrières implicites et explicites
+ * 4. Attente pour entrer dans un critical / un verrou
+ * 5. Nombre de tâches explicites créées
+ *
+ * À la fin du programme: tableau récapitulatif (stderr) + fichier CSV
+ *
+ * IMPORTANT: OMPT n'est pas implémenté par libgomp (GCC).
+ * Il faut le runtime LLVM (libomp), par exemple avec clang:
+ *   clang -fopenmp -O2 -shared -fPIC ompt_profil.c -o libompt_profil.so -ldl
+ *   clang -fopenmp -O2 -rdynamic lab2.c -o lab2_clang
+ *   OMP_TOOL_LIBRARIES=./libompt_profil.so ./lab2_clang
+ *
+ * Variables d'environnement:
+ *   OMPT_PROFIL_CSV   chemin du CSV (défaut: ompt_profil.csv)
+ */
+
+#define _GNU_SOURCE
+#include <omp-tools.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <dlfcn.h>
+#include <pthread.h>
+
+// Nombre max de constructions distinctes suivies par thread
+#define MAX_ENTREES 512
+// Profondeur max de régions parallèles imbriquées par thread
+#define MAX_PROFONDEUR 16
+
+// Catégories de mesures
+typedef enum {
+    CAT_PARALLEL = 0,
+    CAT_BOUCLE,
+    CAT_SECTIONS,
+    CAT_SINGLE,
+    CAT_AUTRE_PARTAGE,
+    CAT_BARRIERE_IMPLICITE,
+    CAT_BARRIERE_EXPLICITE,
+    CAT_TASKWAIT,
+    CAT_CRITICAL,
+    CAT_VERROU,
+    CAT_TACHE,
+    NB_CATEGORIES
+} Categorie;
+
+static const char *noms_categories[NB_CATEGORIES] = {
+    "parallel", "boucle", "sections", "single", "partage-autre",
+    "barriere-implicite", "barriere-explicite", "taskwait",
+    "critical-attente", "verrou-attente", "tache"
+};
+
+// Statistiques cumulées pour une construction (catégorie + adresse)
+typedef struct {
+    int categorie;
+    const void *codeptr;
+    uint64_t nb;          // Nombre d'occurrences
+    uint64_t total_ns;    // Temps cumulé
+    uint64_t max_ns;      // Pire occurrence
+} Entree;
+
+// Table privée à chaque thread: aucune synchronisation sur le chemin chaud
+typedef struct TableThread {
+    Entree entrees[MAX_ENTREES];
+    int nb_entrees;
+    int debordement;
+    struct TableThread *suivante;
+
+    // Débuts en cours (un seul niveau suffit: ces constructions ne s'imbriquent
+    // pas dans un même thread, sauf les régions parallèles)
+    uint64_t debut_travail;
+    uint64_t debut_attente;
+    uint64_t debut_mutex;
+    int profondeur;
+    uint64_t debut_parallel[MAX_PROFONDEUR];
+} TableThread;
+
+// Liste globale des tables (ajout une seule fois par thread)
+static TableThread *toutes_les_tables = NULL;
+static pthread_mutex_t verrou_tables = PTHREAD_MUTEX_INITIALIZER;
+static _Thread_local TableThread *ma_table = NULL;
+
+static uint64_t debut_programme_ns = 0;
+
+static uint64_t maintenant_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static TableThread *table_courante(void) {
+    if (ma_table == NULL) {
+        ma_table = (TableThread*)calloc(1, sizeof(TableThread));
+        pthread_mutex_lock(&verrou_tables);
+        ma_table->suivante = toutes_les_tables;
+        toutes_les_tables = ma_table;
+        pthread_mutex_unlock(&verrou_tables);
+    }
+    return ma_table;
+}
+
+// Ajoute une mesure dans la table du thread (recherche linéaire: peu d'entrées)
+static void enregistrer(int categorie, const void *codeptr, uint64_t duree_ns) {
+    TableThread *t = table_courante();
+    for (int i = 0; i < t->nb_entrees; i++) {
+        Entree *e = &t->entrees[i];
+        if (e->categorie == categorie && e->codeptr == codeptr) {
+            e->nb++;
+            e->total_ns += duree_ns;
+            if (duree_ns > e->max_ns) e->max_ns = duree_ns;
+            return;
+        }
+    }
+    if (t->nb_entrees == MAX_ENTREES) {
+        t->debordement++;
+        return;
+    }
+    Entree *e = &t->entrees[t->nb_entrees++];
+    e->categorie = categorie;
+    e->codeptr = codeptr;
+    e->nb = 1;
+    e->total_ns = duree_ns;
+    e->max_ns = duree_ns;
+}
+
+// ============================================================================
+// CALLBACKS OMPT
+// ============================================================================
+
+static void cb_parallel_begin(ompt_data_t *encountering_task_data,
+                              const ompt_frame_t *encountering_task_frame,
+                              ompt_data_t *parallel_data,
+                              unsigned int requested_parallelism,
+                              int flags, const void *codeptr_ra) {
+    (void)encountering_task_data; (void)encountering_task_frame;
+    (void)parallel_data; (void)requested_parallelism; (void)flags; (void)codeptr_ra;
+    TableThread *t = table_courante();
+    if (t->profondeur < MAX_PROFONDEUR) {
+        t->debut_parallel[t->profondeur] = maintenant_ns();
+    }
+    t->profondeur++;
+}
+
+static void cb_parallel_end(ompt_data_t *parallel_data,
+                            ompt_data_t *encountering_task_data,
+                            int flags, const void *codeptr_ra) {
+    (void)parallel_data; (void)encountering_task_data; (void)flags;
+    TableThread *t = table_courante();
+    if (t->profondeur == 0) return;
+    t->profondeur--;
+    if (t->profondeur < MAX_PROFONDEUR) {
+        enregistrer(CAT_PARALLEL, codeptr_ra,
+                    maintenant_ns() - t->debut_parallel[t->profondeur]);
+    }
+}
+
+static int categorie_travail(ompt_work_t wstype) {
+    switch (wstype) {
+        case ompt_work_sections:        return CAT_SECTIONS;
+        case ompt_work_single_executor:
+        case ompt_work_single_other:    return CAT_SINGLE;
+        case ompt_work_workshare:
+        case ompt_work_distribute:
+        case ompt_work_taskloop:        return CAT_AUTRE_PARTAGE;
+        // ompt_work_loop et ses variantes OpenMP 5.2 (loop_static, ...)
+        default:                        return CAT_BOUCLE;
+    }
+}
+
+static void cb_work(ompt_work_t wstype, ompt_scope_endpoint_t endpoint,
+                    ompt_data_t *parallel_data, ompt_data_t *task_data,
+                    uint64_t count, const void *codeptr_ra) {
+    (void)parallel_data; (void)task_data; (void)count;
+    TableThread *t = table_courante();
+    if (endpoint == ompt_scope_begin) {
+        t->debut_travail = maintenant_ns();
+    } else {
+        enregistrer(categorie_travail(wstype), codeptr_ra,
+                    maintenant_ns() - t->debut_travail);
+    }
+}
+
+static int categorie_sync(ompt_sync_region_t kind) {
+    switch (kind) {
+        case ompt_sync_region_barrier_explicit: return CAT_BARRIERE_EXPLICITE;
+        case ompt_sync_region_taskwait:
+        case ompt_sync_region_taskgroup:        return CAT_TASKWAIT;
+        // barrier, barrier_implicit, barrier_implementation et les
+        // variantes implicit_workshare/implicit_parallel d'OpenMP 5.1
+        default:                                return CAT_BARRIERE_IMPLICITE;
+    }
+}
+
+// Seule la partie "attente" (sync_region_wait) est comptée comme temps perdu
+static void cb_sync_region_wait(ompt_sync_region_t kind,
+                                ompt_scope_endpoint_t endpoint,
+                                ompt_data_t *parallel_data,
+                                ompt_data_t *task_data,
+                                const void *codeptr_ra) {
+    (void)parallel_data; (void)task_data;
+    if (kind == ompt_sync_region_reduction) return;
+    TableThread *t = table_courante();
+    if (endpoint == ompt_scope_begin) {
+        t->debut_attente = maintenant_ns();
+    } else {
+        enregistrer(categorie_sync(kind), codeptr_ra,
+                    maintenant_ns() - t->debut_attente);
+    }
+}
+
+static void cb_mutex_acquire(ompt_mutex_t kind, unsigned int hint,
+                             unsigned int impl, ompt_wait_id_t wait_id,
+                             const void *codeptr_ra) {
+    (void)kind; (void)hint; (void)impl; (void)wait_id; (void)codeptr_ra;
+    table_courante()->debut_mutex = maintenant_ns();
+}
+
+static void cb_mutex_acquired(ompt_mutex_t kind, ompt_wait_id_t wait_id,
+                              const void *codeptr_ra) {
+    (void)wait_id;
+    int categorie = (kind == ompt_mutex_critical) ? CAT_CRITICAL : CAT_VERROU;
+    TableThread *t = table_courante();
+    enregistrer(categorie, codeptr_ra, maintenant_ns() - t->debut_mutex);
+}
+
+static void cb_task_create(ompt_data_t *encountering_task_data,
+                           const ompt_frame_t *encountering_task_frame,
+                           ompt_data_t *new_task_data, int flags,
+                           int has_dependences, const void *codeptr_ra) {
+    (void)encountering_task_data; (void)encountering_task_frame;
+    (void)new_task_data; (void)has_dependences;
+    if (flags & ompt_task_explicit) {
+        enregistrer(CAT_TACHE, codeptr_ra, 0);
+    }
+}
+
+// ============================================================================
+// INITIALISATION / FINALISATION
+// ============================================================================
+
+static int enregistrer_callback(ompt_set_callback_t set_callback,
+                                ompt_callbacks_t evenement,
+                                ompt_callback_t callback, const char *nom) {
+    ompt_set_result_t r = set_callback(evenement, callback);
+    if (r == ompt_set_never || r == ompt_set_error) {
+        fprintf(stderr, "[ompt_profil] callback %s non supporté\n", nom);
+        return 0;
+    }
+    return 1;
+}
+
+static int initialiser_outil(ompt_function_lookup_t lookup,
+                             int initial_device_num, ompt_data_t *tool_data) {
+    (void)initial_device_num; (void)tool_data;
+    ompt_set_callback_t set_callback =
+        (ompt_set_callback_t)lookup("ompt_set_callback");
+    if (set_callback == NULL) return 0;
+
+    debut_programme_ns = maintenant_ns();
+
+    enregistrer_callback(set_callback, ompt_callback_parallel_begin,
+                         (ompt_callback_t)cb_parallel_begin, "parallel_begin");
+    enregistrer_callback(set_callback, ompt_callback_parallel_end,
+                         (ompt_callback_t)cb_parallel_end, "parallel_end");
+    enregistrer_callback(set_callback, ompt_callback_work,
+                         (ompt_callback_t)cb_work, "work");
+    enregistrer_callback(set_callback, ompt_callback_sync_region_wait,
+                         (ompt_callback_t)cb_sync_region_wait, "sync_region_wait");
+    enregistrer_callback(set_callback, ompt_callback_mutex_acquire,
+                         (ompt_callback_t)cb_mutex_acquire, "mutex_acquire");
+    enregistrer_callback(set_callback, ompt_callback_mutex_acquired,
+                         (ompt_callback_t)cb_mutex_acquired, "mutex_acquired");
+    enregistrer_callback(set_callback, ompt_callback_task_create,
+                         (ompt_callback_t)cb_task_create, "task_create");
+
+    return 1;  // Valeur non nulle: l'outil reste actif
+}
+
+// Résolution d'une adresse en "fonction+décalage" (nécessite -rdynamic)
+static void nom_symbole(const void *codeptr, char *buf, size_t taille) {
+    Dl_info info;
+    if (codeptr != NULL && dladdr(codeptr, &info) && info.dli_sname != NULL) {
+        snprintf(buf, taille, "%s+0x%lx", info.dli_sname,
+                 (unsigned long)((const char*)codeptr - (const char*)info.dli_saddr));
+    } else {
+        snprintf(buf, taille, "%p", codeptr);
+    }
+}
+
+static int comparer_entrees(const void *a, const void *b) {
+    const Entree *ea = (const Entree*)a;
+    const Entree *eb = (const Entree*)b;
+    if (ea->categorie != eb->categorie) return ea->categorie - eb->categorie;
+    if (ea->total_ns != eb->total_ns) return (ea->total_ns < eb->total_ns) ? 1 : -1;
+    return 0;
+}
+
+static void finaliser_outil(ompt_data_t *tool_data) {
+    (void)tool_data;
+    double duree_programme = (maintenant_ns() - debut_programme_ns) * 1e-9;
+
+    // Fusion des tables de tous les threads
+    static Entree fusion[MAX_ENTREES];
+    int nb = 0, debordement = 0, nb_threads = 0;
+    uint64_t total_cat[NB_CATEGORIES] = {0};
+
+    for (TableThread *t = toutes_les_tables; t != NULL; t = t->suivante) {
+        nb_threads++;
+        debordement += t->debordement;
+        for (int i = 0; i < t->nb_entrees; i++) {
+            Entree *src = &t->entrees[i];
+            total_cat[src->categorie] += src->total_ns;
+            int j;
+            for (j = 0; j < nb; j++) {
+                if (fusion[j].categorie == src->categorie &&
+                    fusion[j].codeptr == src->codeptr) break;
+            }
+            if (j == nb) {
+                if (nb == MAX_ENTREES) { debordement++; continue; }
+                fusion[nb++] = *src;
+            } else {
+                fusion[j].nb += src->nb;
+                fusion[j].total_ns += src->total_ns;
+                if (src->max_ns > fusion[j].max_ns) fusion[j].max_ns = src->max_ns;
+            }
+        }
+    }
+    qsort(fusion, nb, sizeof(Entree), comparer_entrees);
+
+    // Tableau récapitulatif
+    fprintf(stderr, "\n");
+    fprintf(stderr, "================================================================================\n");
+    fprintf(stderr, "OMPT PROFIL: %d threads observés, durée totale %.4f s\n",
+            nb_threads, duree_programme);
+    fprintf(stderr, "================================================================================\n");
+    fprintf(stderr, "%-20s %-32s %10s %12s %12s %12s\n",
+            "Catégorie", "Construction", "Nombre", "Total (ms)", "Moyen (us)", "Max (us)");
+    fprintf(stderr, "--------------------------------------------------------------------------------\n");
+
+    char symbole[256];
+    for (int i = 0; i < nb; i++) {
+        Entree *e = &fusion[i];
+        nom_symbole(e->codeptr, symbole, sizeof(symbole));
+        fprintf(stderr, "%-20s %-32.32s %10llu %12.3f %12.3f %12.3f\n",
+                noms_categories[e->categorie], symbole,
+                (unsigned long long)e->nb, e->total_ns * 1e-6,
+                e->nb ? (double)e->total_ns / e->nb * 1e-3 : 0.0,
+                e->max_ns * 1e-3);
+    }
+
+    fprintf(stderr, "--------------------------------------------------------------------------------\n");
+    fprintf(stderr, "Totaux par catégorie (somme sur tous les threads):\n");
+    for (int c = 0; c < NB_CATEGORIES; c++) {
+        if (total_cat[c] == 0) continue;
+        fprintf(stderr, "   %-20s %12.3f ms\n", noms_categories[c], total_cat[c] * 1e-6);
+    }
+    uint64_t attente = total_cat[CAT_BARRIERE_IMPLICITE] + total_cat[CAT_BARRIERE_EXPLICITE]
+                     + total_cat[CAT_TASKWAIT] + total_cat[CAT_CRITICAL] + total_cat[CAT_VERROU];
+    fprintf(stderr, "   Temps d'inactivité (barrières + attentes de verrous): %.3f ms\n",
+            attente * 1e-6);
+    if (debordement > 0) {
+        fprintf(stderr, "   ⚠️  %d mesures ignorées (augmenter MAX_ENTREES)\n", debordement);
+    }
+
+    // Fichier CSV
+    const char *chemin = getenv("OMPT_PROFIL_CSV");
+    if (chemin == NULL) chemin = "ompt_profil.csv";
+    FILE *fp = fopen(chemin, "w");
+    if (fp == NULL) {
+        fprintf(stderr, "Erreur: Impossible de créer le fichier CSV %s\n", chemin);
+        return;
+    }
+    fprintf(fp, "Categorie,Construction,Adresse,Nombre,Total_ns,Moyen_ns,Max_ns\n");
+    for (int i = 0; i < nb; i++) {
+        Entree *e = &fusion[i];
+        nom_symbole(e->codeptr, symbole, sizeof(symbole));
+        fprintf(fp, "%s,%s,%p,%llu,%llu,%.1f,%llu\n",
+                noms_categories[e->categorie], symbole, e->codeptr,
+                (unsigned long long)e->nb, (unsigned long long)e->total_ns,
+                e->nb ? (double)e->total_ns / e->nb : 0.0,
+                (unsigned long long)e->max_ns);
+    }
+    fclose(fp);
+    fprintf(stderr, "Fichier CSV généré: %s\n", chemin);
+}
+
+// Point d'entrée appelé par le runtime OpenMP au démarrage
+ompt_start_tool_result_t *ompt_start_tool(unsigned int omp_version,
+                                          const char *runtime_version) {
+    (void)omp_version;
+    static ompt_start_tool_result_t resultat = {
+        &initialiser_outil, &finaliser_outil, {0}
+    };
+    fprintf(stderr, "[ompt_profil] Outil chargé (runtime: %s)\n", runtime_version);
+    return &resultat;
+}
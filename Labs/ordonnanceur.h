@@ -0,0 +1,252 @@
+/*
+ * ORDONNANCEUR: Ordonnancement de boucles au-delà de static/dynamic/guided
+ *
+ * Bibliothèque "header-only": il suffit d'inclure ce fichier.
+ *
+ * Ordonnancements disponibles:
+ * 1. FACTORING  - Lots de P chunks, chaque lot fait la moitié du reste / P
+ * 2. TSS        - Trapezoid Self-Scheduling: chunks décroissants linéairement
+ * 3. PONDÉRÉ    - Partition statique selon un modèle de coût (callback)
+ * 4. ADAPTATIF  - Taille de chunk ajustée au débit mesuré de chaque thread
+ *
+ * Utilisation (dans une région parallèle):
+ *
+ *   Ordonnanceur ordo;
+ *   ordo_init(&ordo, ORDO_FACTORING, 2, n + 1, num_threads, 1, NULL, NULL);
+ *   #pragma omp parallel num_threads(num_threads)
+ *   {
+ *       OrdoEtatThread etat;
+ *       ordo_etat_init(&etat);
+ *       long debut, fin;
+ *       while (ordo_prochain(&ordo, &etat, &debut, &fin)) {
+ *           for (long i = debut; i < fin; i++) { ... }
+ *       }
+ *   }
+ *   ordo_liberer(&ordo);
+ */
+
+#ifndef ORDONNANCEUR_H
+#define ORDONNANCEUR_H
+
+#include <stdlib.h>
+#include <math.h>
+#include <omp.h>
+
+typedef enum {
+    ORDO_FACTORING = 0,
+    ORDO_TSS,
+    ORDO_PONDERE,
+    ORDO_ADAPTATIF,
+    ORDO_NB_TYPES
+} TypeOrdo;
+
+static const char *const ordo_noms[ORDO_NB_TYPES] = {
+    "factoring", "tss", "pondere", "adaptatif"
+};
+
+// Coût estimé de l'itération i (unité arbitraire)
+typedef double (*CoutIteration)(long i, void *ctx);
+
+// Durée visée pour un chunk en mode adaptatif (secondes)
+#define ORDO_QUANTUM_ADAPTATIF 50e-6
+
+typedef struct {
+    TypeOrdo type;
+    long debut, fin;           // Itérations [debut, fin)
+    int nb_threads;
+    long chunk_min;
+
+    // FACTORING / TSS: bornes des chunks précalculées (nb_chunks + 1 valeurs)
+    long *bornes;
+    long nb_chunks;
+
+    // PONDÉRÉ: bornes des partitions par thread (nb_threads + 1 valeurs)
+    long *partitions;
+
+    // Compteur partagé: prochain chunk (FACTORING/TSS) ou itération (ADAPTATIF)
+    long suivant;
+} Ordonnanceur;
+
+// État privé de chaque thread
+typedef struct {
+    int partition;             // PONDÉRÉ: prochaine partition (-1: aucune prise)
+    long taille_dernier;       // ADAPTATIF: taille du dernier chunk
+    double t_dernier;          // ADAPTATIF: date de début du dernier chunk
+    double debit;              // ADAPTATIF: itérations par seconde (moyenne glissante)
+} OrdoEtatThread;
+
+// Précalcul des chunks FACTORING: lots de P chunks de taille ceil(R / 2P)
+static inline long ordo_construire_factoring(Ordonnanceur *o) {
+    long capacite = 64;
+    o->bornes = (long*)malloc((capacite + 1) * sizeof(long));
+    long nb = 0, pos = o->debut;
+    o->bornes[0] = pos;
+    while (pos < o->fin) {
+        long reste = o->fin - pos;
+        long taille = (reste + 2L * o->nb_threads - 1) / (2L * o->nb_threads);
+        if (taille < o->chunk_min) taille = o->chunk_min;
+        for (int p = 0; p < o->nb_threads && pos < o->fin; p++) {
+            if (nb == capacite) {
+                capacite *= 2;
+                o->bornes = (long*)realloc(o->bornes, (capacite + 1) * sizeof(long));
+            }
+            pos = (pos + taille < o->fin) ? pos + taille : o->fin;
+            o->bornes[++nb] = pos;
+        }
+    }
+    return nb;
+}
+
+// Précalcul des chunks TSS: premier = N/2P, dernier = chunk_min, décroissance linéaire
+static inline long ordo_construire_tss(Ordonnanceur *o) {
+    long n = o->fin - o->debut;
+    double premier = (double)n / (2.0 * o->nb_threads);
+    double dernier = (double)o->chunk_min;
+    if (premier < dernier) premier = dernier;
+    long nb_max = (long)ceil(2.0 * n / (premier + dernier));
+    double delta = (nb_max > 1) ? (premier - dernier) / (nb_max - 1) : 0.0;
+
+    o->bornes = (long*)malloc((nb_max + 2) * sizeof(long));
+    long nb = 0, pos = o->debut;
+    o->bornes[0] = pos;
+    double taille = premier;
+    while (pos < o->fin) {
+        long t = (long)taille;
+        if (t < o->chunk_min) t = o->chunk_min;
+        if (nb == nb_max + 1) t = o->fin - pos;  // Sécurité: dernier chunk
+        pos = (pos + t < o->fin) ? pos + t : o->fin;
+        o->bornes[++nb] = pos;
+        taille -= delta;
+    }
+    return nb;
+}
+
+// Partition statique: chaque thread reçoit ~1/P du coût total
+static inline void ordo_construire_pondere(Ordonnanceur *o, CoutIteration cout, void *ctx) {
+    o->partitions = (long*)malloc((o->nb_threads + 1) * sizeof(long));
+
+    double total = 0.0;
+    for (long i = o->debut; i < o->fin; i++) {
+        total += cout ? cout(i, ctx) : 1.0;
+    }
+
+    o->partitions[0] = o->debut;
+    double cumul = 0.0;
+    int t = 1;
+    for (long i = o->debut; i < o->fin && t < o->nb_threads; i++) {
+        cumul += cout ? cout(i, ctx) : 1.0;
+        while (t < o->nb_threads && cumul >= total * t / o->nb_threads) {
+            o->partitions[t++] = i + 1;
+        }
+    }
+    while (t <= o->nb_threads) {
+        o->partitions[t++] = o->fin;
+    }
+}
+
+// Initialisation (hors région parallèle)
+static inline void ordo_init(Ordonnanceur *o, TypeOrdo type, long debut, long fin,
+                             int nb_threads, long chunk_min,
+                             CoutIteration cout, void *ctx) {
+    o->type = type;
+    o->debut = debut;
+    o->fin = (fin > debut) ? fin : debut;
+    o->nb_threads = (nb_threads > 0) ? nb_threads : 1;
+    o->chunk_min = (chunk_min > 0) ? chunk_min : 1;
+    o->bornes = NULL;
+    o->nb_chunks = 0;
+    o->partitions = NULL;
+    o->suivant = (type == ORDO_ADAPTATIF) ? debut : 0;
+
+    switch (type) {
+        case ORDO_FACTORING: o->nb_chunks = ordo_construire_factoring(o); break;
+        case ORDO_TSS:       o->nb_chunks = ordo_construire_tss(o); break;
+        case ORDO_PONDERE:   ordo_construire_pondere(o, cout, ctx); break;
+        default:             break;
+    }
+}
+
+static inline void ordo_liberer(Ordonnanceur *o) {
+    free(o->bornes);
+    free(o->partitions);
+    o->bornes = NULL;
+    o->partitions = NULL;
+}
+
+static inline void ordo_etat_init(OrdoEtatThread *e) {
+    e->partition = -1;
+    e->taille_dernier = 0;
+    e->t_dernier = 0.0;
+    e->debit = 0.0;
+}
+
+// Chunk suivant pour le thread appelant: retourne 0 quand la boucle est finie
+static inline int ordo_prochain(Ordonnanceur *o, OrdoEtatThread *e, long *debut, long *fin) {
+    switch (o->type) {
+        case ORDO_FACTORING:
+        case ORDO_TSS: {
+            long k;
+            #pragma omp atomic capture
+            k = o->suivant++;
+            if (k >= o->nb_chunks) return 0;
+            *debut = o->bornes[k];
+            *fin = o->bornes[k + 1];
+            return 1;
+        }
+
+        case ORDO_PONDERE: {
+            // Partitions tid, tid + T, tid + 2T...: si l'équipe réelle est
+            // plus petite que nb_threads (OMP_THREAD_LIMIT, OMP_DYNAMIC,
+            // imbrication), aucune partition n'est oubliée
+            do {
+                e->partition = (e->partition < 0) ? omp_get_thread_num()
+                                                  : e->partition + omp_get_num_threads();
+                if (e->partition >= o->nb_threads) return 0;
+                *debut = o->partitions[e->partition];
+                *fin = o->partitions[e->partition + 1];
+            } while (*fin <= *debut);
+            return 1;
+        }
+
+        case ORDO_ADAPTATIF: {
+            double maintenant = omp_get_wtime();
+            // Mise à jour du débit observé sur le chunk précédent
+            if (e->taille_dernier > 0) {
+                double duree = maintenant - e->t_dernier;
+                if (duree > 0) {
+                    double debit = e->taille_dernier / duree;
+                    e->debit = (e->debit > 0) ? 0.5 * e->debit + 0.5 * debit : debit;
+                }
+            }
+
+            long reste;
+            #pragma omp atomic read
+            reste = o->suivant;
+            reste = o->fin - reste;
+            if (reste <= 0) return 0;
+
+            // Chunk visant ORDO_QUANTUM_ADAPTATIF, borné par reste/2P (comme guided)
+            long taille = (e->debit > 0) ? (long)(e->debit * ORDO_QUANTUM_ADAPTATIF)
+                                         : o->chunk_min;
+            long plafond = reste / (2L * o->nb_threads);
+            if (taille > plafond) taille = plafond;
+            if (taille < o->chunk_min) taille = o->chunk_min;
+
+            long d;
+            #pragma omp atomic capture
+            { d = o->suivant; o->suivant += taille; }
+            if (d >= o->fin) return 0;
+
+            *debut = d;
+            *fin = (d + taille < o->fin) ? d + taille : o->fin;
+            e->taille_dernier = *fin - *debut;
+            e->t_dernier = maintenant;
+            return 1;
+        }
+
+        default:
+            return 0;
+    }
+}
+
+#endif
@@ -0,0 +1,104 @@
+/*
+ * PARTITION: Allocation, initialisation et calcul sur la même partition
+ *
+ * Bibliothèque "header-only". Le motif de master_example.c (le master
+ * alloue et remplit, les autres attendent, puis chacun calcule sa tranche)
+ * a deux défauts:
+ * - l'initialisation est séquentielle
+ * - politique du premier contact (Linux): une page physique est placée
+ *   sur le nœud NUMA du thread qui l'écrit EN PREMIER. Tout le tableau
+ *   est donc sur le nœud du master, et sur une machine à plusieurs
+ *   sockets les autres threads calculent en mémoire distante.
+ *
+ *   master seul:   nœud 0 [████████████████]   nœud 1 [                ]
+ *   partition:     nœud 0 [████████        ]   nœud 1 [        ████████]
+ *                          T0 T1 T2 T3                 T4 T5 T6 T7
+ *
+ * Ici:
+ * - partition_allouer: allocation dans un single, pointeur diffusé à
+ *   toute l'équipe (copyprivate); aucune page n'est encore touchée
+ * - partition_tranche: tranche [debut, fin) du thread, identique pour
+ *   l'initialisation et le calcul, bornes alignées sur les pages (une
+ *   page n'est écrite que par un thread)
+ * - partition_executer: les trois étapes dans une seule région parallèle,
+ *   le résultat du calcul par reduction(+)
+ *
+ * Utilisation (dans une région parallèle):
+ *
+ *   #pragma omp parallel reduction(+:somme)
+ *   {
+ *       int *d = (int*)partition_allouer(n * sizeof(int));
+ *       size_t debut, fin;
+ *       partition_tranche(n, sizeof(int), &debut, &fin);
+ *       for (size_t i = debut; i < fin; i++) d[i] = ...;   // premier contact
+ *       for (size_t i = debut; i < fin; i++) somme += d[i]; // mêmes pages
+ *   }
+ *
+ * ou, avec des fonctions par tranche:
+ *
+ *   int *d = partition_executer(n, sizeof(int), init, calcul, arg, &somme);
+ */
+
+#ifndef PARTITION_H
+#define PARTITION_H
+
+#include <stdlib.h>
+#include <omp.h>
+
+#define PARTITION_PAGE 4096
+
+// Pour chaque tranche [debut, fin) du thread courant
+typedef void (*PartitionInit)(void *donnees, size_t debut, size_t fin, void *arg);
+typedef double (*PartitionCalcul)(const void *donnees, size_t debut, size_t fin, void *arg);
+
+// À appeler par TOUS les threads de l'équipe: un seul alloue, tous
+// reçoivent le même pointeur (barrière implicite du single)
+static inline void *partition_allouer(size_t octets) {
+    void *p = NULL;
+    #pragma omp single copyprivate(p)
+    {
+        size_t arrondi = (octets + PARTITION_PAGE - 1) / PARTITION_PAGE * PARTITION_PAGE;
+        p = aligned_alloc(PARTITION_PAGE, arrondi > 0 ? arrondi : PARTITION_PAGE);
+    }
+    return p;
+}
+
+// Tranche du thread courant: découpage en blocs égaux (comme
+// schedule(static)), bornes arrondies à une page de "taille" octets
+static inline void partition_tranche(size_t n, size_t taille, size_t *debut, size_t *fin) {
+    size_t id = (size_t)omp_get_thread_num();
+    size_t nb = (size_t)omp_get_num_threads();
+    size_t par_page = (taille < PARTITION_PAGE) ? PARTITION_PAGE / taille : 1;
+    size_t nb_pages = (n + par_page - 1) / par_page;
+    *debut = nb_pages * id / nb * par_page;
+    *fin = nb_pages * (id + 1) / nb * par_page;
+    if (*debut > n) *debut = n;
+    if (*fin > n) *fin = n;
+}
+
+// Alloue n éléments, init puis calcul sur la même tranche par thread;
+// *resultat = somme des calculs. Retourne le tableau (free par l'appelant),
+// NULL si l'allocation échoue.
+static inline void *partition_executer(size_t n, size_t taille, PartitionInit init,
+                                       PartitionCalcul calcul, void *arg, double *resultat) {
+    void *donnees = NULL;
+    double somme = 0.0;
+
+    #pragma omp parallel reduction(+:somme)
+    {
+        void *d = partition_allouer(n * taille);
+        if (d != NULL) {
+            size_t debut, fin;
+            partition_tranche(n, taille, &debut, &fin);
+            init(d, debut, fin, arg);
+            somme += calcul(d, debut, fin, arg);
+        }
+        #pragma omp master
+        donnees = d;
+    }
+
+    *resultat = somme;
+    return donnees;
+}
+
+#endif
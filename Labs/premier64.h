@@ -0,0 +1,244 @@
+/*
+ * PREMIER64: Test de primalité déterministe sur 64 bits, par lots
+ *
+ * Bibliothèque "header-only" pour tester des tableaux de uint64_t.
+ *
+ * Principe:
+ * - Division par les petits premiers (élimine ~80% des candidats aléatoires)
+ * - Miller-Rabin avec les 7 bases de Sinclair:
+ *   {2, 325, 9375, 28178, 450775, 9780504, 1795265022}
+ *   => résultat EXACT pour tout n < 2^64 (aucun faux positif)
+ * - Arithmétique de Montgomery: pas de division 128 bits dans la boucle
+ * - Exponentiation par fenêtre fixe de 2 bits (sans branchement sur d)
+ * - 4 candidats entrelacés (4 chaînes de multiplications indépendantes):
+ *   la multiplication 64x64->128 n'existe pas en SIMD (AVX2), on exploite
+ *   donc le parallélisme d'instructions du cœur plutôt que les vecteurs
+ * - Les lots sont répartis entre threads avec OpenMP
+ *
+ * API:
+ *   int  premier64_est_premier(uint64_t n);
+ *   void premier64_test_lot(const uint64_t *candidats, uint8_t *resultats,
+ *                           size_t nb, int num_threads);
+ */
+
+#ifndef PREMIER64_H
+#define PREMIER64_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <omp.h>
+
+#define PREMIER64_NB_BASES 7
+static const uint64_t PREMIER64_BASES[PREMIER64_NB_BASES] = {
+    2, 325, 9375, 28178, 450775, 9780504, 1795265022
+};
+
+#define PREMIER64_NB_PETITS 15
+static const uint32_t PREMIER64_PETITS[PREMIER64_NB_PETITS] = {
+    2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47
+};
+// En dessous de 47², un nombre sans petit facteur est premier
+#define PREMIER64_LIMITE_PETITS (47u * 47u)
+
+// Résultat de la division par les petits premiers
+#define PREMIER64_COMPOSE 0
+#define PREMIER64_PREMIER 1
+#define PREMIER64_INDECIS 2
+
+// ============================================================================
+// ARITHMÉTIQUE DE MONTGOMERY (R = 2^64, n impair)
+// ============================================================================
+
+typedef struct {
+    uint64_t n;
+    uint64_t ninv;     // n^-1 mod 2^64
+    uint64_t r2;       // R² mod n (conversion vers Montgomery)
+    uint64_t un;       // R mod n (1 en représentation de Montgomery)
+    uint64_t moins_un; // n - R mod n (-1 en représentation de Montgomery)
+    uint64_t d;        // n - 1 = d * 2^s, d impair
+    int s;
+} Montgomery64;
+
+static inline uint64_t mont_mul(uint64_t a, uint64_t b, uint64_t n, uint64_t ninv) {
+    __uint128_t t = (__uint128_t)a * b;
+    uint64_t lo = (uint64_t)t;
+    uint64_t hi = (uint64_t)(t >> 64);
+    uint64_t m = lo * ninv;
+    uint64_t mn_hi = (uint64_t)(((__uint128_t)m * n) >> 64);
+    // (t - m*n) / 2^64 = hi - mn_hi, dans ]-n, n[
+    return (hi >= mn_hi) ? hi - mn_hi : hi - mn_hi + n;
+}
+
+static inline void mont_init(Montgomery64 *m, uint64_t n) {
+    m->n = n;
+    // Newton: chaque itération double le nombre de bits corrects (3 -> 96)
+    uint64_t inv = n;
+    for (int i = 0; i < 5; i++) inv *= 2 - n * inv;
+    // mont_mul soustrait m*n: il faut n^-1 (et non -n^-1)
+    m->ninv = inv;
+    m->un = (uint64_t)(-n) % n;
+    m->r2 = (uint64_t)(((__uint128_t)m->un * m->un) % n);
+    m->moins_un = n - m->un;
+    m->d = n - 1;
+    m->s = __builtin_ctzll(m->d);
+    m->d >>= m->s;
+}
+
+// ============================================================================
+// TEST SCALAIRE
+// ============================================================================
+
+static inline int premier64_petits(uint64_t n) {
+    if (n < 2) return PREMIER64_COMPOSE;
+    for (int i = 0; i < PREMIER64_NB_PETITS; i++) {
+        if (n == PREMIER64_PETITS[i]) return PREMIER64_PREMIER;
+        if (n % PREMIER64_PETITS[i] == 0) return PREMIER64_COMPOSE;
+    }
+    if (n < PREMIER64_LIMITE_PETITS) return PREMIER64_PREMIER;
+    return PREMIER64_INDECIS;
+}
+
+// Un tour de Miller-Rabin: 1 si n est probablement premier pour la base
+static inline int premier64_temoin(const Montgomery64 *m, uint64_t base) {
+    uint64_t a = base % m->n;
+    if (a == 0) return 1;
+    uint64_t am = mont_mul(a, m->r2, m->n, m->ninv);
+
+    // x = a^d (exponentiation binaire de gauche à droite)
+    uint64_t x = m->un;
+    for (int bit = 63 - __builtin_clzll(m->d); bit >= 0; bit--) {
+        x = mont_mul(x, x, m->n, m->ninv);
+        if ((m->d >> bit) & 1) x = mont_mul(x, am, m->n, m->ninv);
+    }
+    if (x == m->un || x == m->moins_un) return 1;
+    for (int i = 1; i < m->s; i++) {
+        x = mont_mul(x, x, m->n, m->ninv);
+        if (x == m->moins_un) return 1;
+    }
+    return 0;
+}
+
+static inline int premier64_miller_rabin(uint64_t n) {
+    Montgomery64 m;
+    mont_init(&m, n);
+    for (int b = 0; b < PREMIER64_NB_BASES; b++) {
+        if (!premier64_temoin(&m, PREMIER64_BASES[b])) return 0;
+    }
+    return 1;
+}
+
+static inline int premier64_est_premier(uint64_t n) {
+    int r = premier64_petits(n);
+    if (r != PREMIER64_INDECIS) return r;
+    return premier64_miller_rabin(n);
+}
+
+// ============================================================================
+// TEST ENTRELACÉ DE 4 CANDIDATS
+// ============================================================================
+
+// Les 4 candidats doivent être impairs et avoir passé premier64_petits
+static inline void premier64_miller_rabin_x4(const uint64_t n[4], uint8_t res[4]) {
+    Montgomery64 m[4];
+    int vivant[4];
+    int bit_max = 0;
+    for (int l = 0; l < 4; l++) {
+        mont_init(&m[l], n[l]);
+        vivant[l] = 1;
+        int b = 63 - __builtin_clzll(m[l].d);
+        if (b > bit_max) bit_max = b;
+    }
+    // Fenêtre fixe de 2 bits: on part d'un bit de poids fort impair
+    bit_max |= 1;
+
+    for (int b = 0; b < PREMIER64_NB_BASES; b++) {
+        if (!(vivant[0] | vivant[1] | vivant[2] | vivant[3])) break;
+
+        // puiss[l] = {1, a, a², a³} en représentation de Montgomery
+        uint64_t puiss[4][4], x[4];
+        for (int l = 0; l < 4; l++) {
+            uint64_t a = PREMIER64_BASES[b] % m[l].n;
+            uint64_t am = mont_mul(a, m[l].r2, m[l].n, m[l].ninv);
+            puiss[l][0] = m[l].un;
+            puiss[l][1] = am;
+            puiss[l][2] = mont_mul(am, am, m[l].n, m[l].ninv);
+            puiss[l][3] = mont_mul(puiss[l][2], am, m[l].n, m[l].ninv);
+            x[l] = m[l].un;
+        }
+
+        // Exponentiations en parallèle, 2 bits de d par tour: 2 carrés puis
+        // une multiplication par la table (pas de branchement dépendant de d)
+        for (int bit = bit_max; bit > 0; bit -= 2) {
+            for (int l = 0; l < 4; l++) {
+                uint64_t y = mont_mul(x[l], x[l], m[l].n, m[l].ninv);
+                y = mont_mul(y, y, m[l].n, m[l].ninv);
+                x[l] = mont_mul(y, puiss[l][(m[l].d >> (bit - 1)) & 3], m[l].n, m[l].ninv);
+            }
+        }
+
+        for (int l = 0; l < 4; l++) {
+            if (!vivant[l] || puiss[l][1] == 0) continue;
+            uint64_t y = x[l];
+            int ok = (y == m[l].un || y == m[l].moins_un);
+            for (int i = 1; i < m[l].s && !ok; i++) {
+                y = mont_mul(y, y, m[l].n, m[l].ninv);
+                ok = (y == m[l].moins_un);
+            }
+            if (!ok) vivant[l] = 0;
+        }
+    }
+
+    for (int l = 0; l < 4; l++) res[l] = (uint8_t)vivant[l];
+}
+
+// ============================================================================
+// API PAR LOTS
+// ============================================================================
+
+#define PREMIER64_BLOC 4096
+
+// resultats[i] = 1 si candidats[i] est premier, 0 sinon
+static inline void premier64_test_lot(const uint64_t *candidats, uint8_t *resultats,
+                                      size_t nb, int num_threads) {
+    size_t nb_blocs = (nb + PREMIER64_BLOC - 1) / PREMIER64_BLOC;
+
+    #pragma omp parallel for schedule(dynamic, 4) num_threads(num_threads)
+    for (size_t bloc = 0; bloc < nb_blocs; bloc++) {
+        size_t debut = bloc * PREMIER64_BLOC;
+        size_t fin = (debut + PREMIER64_BLOC < nb) ? debut + PREMIER64_BLOC : nb;
+
+        uint64_t file[4];
+        size_t index[4];
+        uint8_t res[4];
+        int nb_file = 0;
+
+        for (size_t i = debut; i < fin; i++) {
+            int r = premier64_petits(candidats[i]);
+            if (r != PREMIER64_INDECIS) {
+                resultats[i] = (uint8_t)r;
+                continue;
+            }
+            file[nb_file] = candidats[i];
+            index[nb_file] = i;
+            if (++nb_file == 4) {
+                premier64_miller_rabin_x4(file, res);
+                for (int l = 0; l < 4; l++) resultats[index[l]] = res[l];
+                nb_file = 0;
+            }
+        }
+        for (int l = 0; l < nb_file; l++) {
+            resultats[index[l]] = (uint8_t)premier64_miller_rabin(file[l]);
+        }
+    }
+}
+
+// Version sans entrelacement (référence pour le benchmark)
+static inline void premier64_test_lot_scalaire(const uint64_t *candidats, uint8_t *resultats,
+                                               size_t nb, int num_threads) {
+    #pragma omp parallel for schedule(dynamic, PREMIER64_BLOC) num_threads(num_threads)
+    for (size_t i = 0; i < nb; i++) {
+        resultats[i] = (uint8_t)premier64_est_premier(candidats[i]);
+    }
+}
+
+#endif
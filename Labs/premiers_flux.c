@@ -0,0 +1,437 @@
+/*
+ * FLUX DE PREMIERS: export binaire compact (deltas + varint) en streaming
+ *
+ * afficher_premiers (lab3) fait un printf par nombre: inutilisable pour
+ * exporter tous les premiers jusqu'à 1e10. Ici:
+ * - le crible segmenté (crible.h) est découpé en tranches de segments
+ * - chaque thread encode les premiers de sa tranche dans son propre tampon:
+ *   écart (p - précédent) / 2 en varint LEB128 (1 octet tant que l'écart < 256)
+ * - les tampons sont écrits dans l'ordre (omp for ordered) avec un seul
+ *   writev par tranche
+ * - le premier écart d'une tranche dépend de la tranche précédente: il est
+ *   encodé au moment de l'écriture et envoyé comme préfixe du writev
+ *
+ * Format: "PRIMFLX1" | limite (uint64) | varints des écarts des premiers
+ * impairs (le premier depuis 1). Le nombre 2 est implicite si limite >= 2.
+ *
+ * Usage:
+ *   ./premiers_flux                       # Démo: écriture, relecture, comparaison texte
+ *   ./premiers_flux ecrire N [fichier|-]  # Écrit les premiers <= N (- = stdout)
+ *   ./premiers_flux lire [fichier|-]      # Décode et vérifie
+ *   ./premiers_flux texte [fichier|-]     # Décode et affiche un premier par ligne
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/uio.h>
+#include <omp.h>
+#include "crible.h"
+
+#define FLUX_MAGIQUE "PRIMFLX1"
+#define FLUX_FICHIER_DEFAUT "premiers.bin"
+#define FLUX_SEGMENTS_PAR_TRANCHE 16      // 8M nombres, ~400 Ko de sortie vers 1e9
+#define FLUX_TAMPON_LECTURE (1 << 20)
+#define VARINT_MAX 10
+
+typedef struct {
+    uint64_t nb_premiers;
+    uint64_t nb_octets;
+    uint64_t somme;        // Somme des premiers modulo 2^64 (contrôle)
+    uint64_t dernier;
+} FluxStats;
+
+typedef struct {
+    uint8_t *octets;
+    size_t taille;
+    size_t capacite;
+    uint64_t premier;      // Premier nombre premier de la tranche (0 = aucun)
+    uint64_t dernier;
+} TamponFlux;
+
+static inline size_t varint_encoder(uint64_t v, uint8_t *sortie) {
+    size_t n = 0;
+    while (v >= 0x80) {
+        sortie[n++] = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    sortie[n++] = (uint8_t)v;
+    return n;
+}
+
+static void tampon_reserver(TamponFlux *t, size_t supplement) {
+    if (t->taille + supplement <= t->capacite) return;
+    while (t->capacite < t->taille + supplement) {
+        t->capacite = t->capacite ? t->capacite * 2 : (1 << 16);
+    }
+    t->octets = (uint8_t*)realloc(t->octets, t->capacite);
+}
+
+// Ajoute les premiers d'un segment [lo, hi) au tampon de la tranche
+static void tampon_encoder_segment(TamponFlux *t, const uint64_t *bits, uint64_t lo, size_t nb_bits,
+                                   uint64_t *somme) {
+    size_t nb_mots = (nb_bits + 63) / 64;
+    tampon_reserver(t, crible_compter_bits(bits, nb_bits) * VARINT_MAX);
+
+    uint8_t *sortie = t->octets + t->taille;
+    uint64_t precedent = t->dernier;
+    for (size_t w = 0; w < nb_mots; w++) {
+        uint64_t mot = bits[w];
+        while (mot) {
+            uint64_t p = lo + 2 * (w * 64 + (uint64_t)__builtin_ctzll(mot)) + 1;
+            mot &= mot - 1;
+            if (t->premier == 0) {
+                t->premier = p;   // Son écart sera encodé à l'écriture
+            } else {
+                sortie += varint_encoder((p - precedent) / 2, sortie);
+            }
+            precedent = p;
+            *somme += p;
+        }
+    }
+    t->taille = (size_t)(sortie - t->octets);
+    t->dernier = precedent;
+}
+
+// writev complet (un pipe peut n'accepter qu'une partie des octets)
+static int ecrire_tout(int fd, struct iovec *iov, int nb_iov) {
+    while (nb_iov > 0) {
+        ssize_t n = writev(fd, iov, nb_iov);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        while (nb_iov > 0 && (size_t)n >= iov->iov_len) {
+            n -= (ssize_t)iov->iov_len;
+            iov++;
+            nb_iov--;
+        }
+        if (nb_iov > 0) {
+            iov->iov_base = (uint8_t*)iov->iov_base + n;
+            iov->iov_len -= (size_t)n;
+        }
+    }
+    return 0;
+}
+
+// ============================================================================
+// ÉCRITURE
+// ============================================================================
+
+static int flux_ecrire_premiers(int fd, uint64_t n, int num_threads, FluxStats *stats) {
+    uint8_t entete[16];
+    memcpy(entete, FLUX_MAGIQUE, 8);
+    memcpy(entete + 8, &n, 8);
+    struct iovec iov_entete = {entete, sizeof(entete)};
+    if (ecrire_tout(fd, &iov_entete, 1) != 0) return -1;
+
+    memset(stats, 0, sizeof(*stats));
+    stats->nb_octets = sizeof(entete);
+    if (n < 2) return 0;
+
+    size_t nb_base;
+    uint32_t *base = crible_premiers_base((uint32_t)crible_isqrt(n), &nb_base);
+    uint64_t fin = n + 1;
+    uint64_t nb_segments = (fin + CRIBLE_SEGMENT_NOMBRES - 1) / CRIBLE_SEGMENT_NOMBRES;
+    uint64_t nb_tranches = (nb_segments + FLUX_SEGMENTS_PAR_TRANCHE - 1) / FLUX_SEGMENTS_PAR_TRANCHE;
+
+    // Partagés, modifiés uniquement dans la région ordered
+    uint64_t dernier = 1;
+    uint64_t nb_octets = 0;
+    int erreur = 0;
+    uint64_t nb_premiers = 1, somme = 2;   // Le nombre 2
+
+    #pragma omp parallel num_threads(num_threads) reduction(+:nb_premiers, somme)
+    {
+        uint64_t *bits = (uint64_t*)malloc(CRIBLE_SEGMENT_OCTETS);
+        TamponFlux tampon = {NULL, 0, 0, 0, 0};
+
+        #pragma omp for ordered schedule(dynamic, 1)
+        for (uint64_t t = 0; t < nb_tranches; t++) {
+            tampon.taille = 0;
+            tampon.premier = 0;
+            tampon.dernier = 0;
+
+            uint64_t s_fin = (t + 1) * FLUX_SEGMENTS_PAR_TRANCHE;
+            if (s_fin > nb_segments) s_fin = nb_segments;
+            for (uint64_t s = t * FLUX_SEGMENTS_PAR_TRANCHE; s < s_fin; s++) {
+                uint64_t lo = s * CRIBLE_SEGMENT_NOMBRES;
+                uint64_t hi = (lo + CRIBLE_SEGMENT_NOMBRES < fin) ? lo + CRIBLE_SEGMENT_NOMBRES : fin;
+                crible_segment_impairs(base, nb_base, lo, hi, bits);
+                nb_premiers += crible_compter_bits(bits, crible_nb_bits(lo, hi));
+                tampon_encoder_segment(&tampon, bits, lo, crible_nb_bits(lo, hi), &somme);
+            }
+
+            #pragma omp ordered
+            {
+                if (tampon.premier != 0 && !erreur) {
+                    uint8_t prefixe[VARINT_MAX];
+                    struct iovec iov[2] = {
+                        {prefixe, varint_encoder((tampon.premier - dernier) / 2, prefixe)},
+                        {tampon.octets, tampon.taille}
+                    };
+                    nb_octets += iov[0].iov_len + iov[1].iov_len;
+                    if (ecrire_tout(fd, iov, 2) != 0) erreur = 1;
+                    dernier = tampon.dernier;
+                }
+            }
+        }
+
+        free(tampon.octets);
+        free(bits);
+    }
+    free(base);
+
+    stats->nb_premiers = nb_premiers;
+    stats->nb_octets += nb_octets;
+    stats->somme = somme;
+    stats->dernier = (dernier > 1) ? dernier : 2;
+    return erreur ? -1 : 0;
+}
+
+// ============================================================================
+// LECTURE
+// ============================================================================
+
+// Décode un flux; si texte != NULL, écrit chaque premier sur une ligne
+static int flux_decoder(int fd, FluxStats *stats, uint64_t *limite, FILE *texte) {
+    uint8_t *tampon = (uint8_t*)malloc(FLUX_TAMPON_LECTURE);
+    memset(stats, 0, sizeof(*stats));
+
+    // Entête (peut arriver en plusieurs morceaux sur un pipe)
+    size_t lus = 0;
+    while (lus < 16) {
+        ssize_t n = read(fd, tampon + lus, 16 - lus);
+        if (n <= 0) break;
+        lus += (size_t)n;
+    }
+    if (lus < 16 || memcmp(tampon, FLUX_MAGIQUE, 8) != 0) {
+        fprintf(stderr, "Erreur: flux de premiers invalide\n");
+        free(tampon);
+        return -1;
+    }
+    memcpy(limite, tampon + 8, 8);
+    stats->nb_octets = 16;
+
+    uint64_t p = 1, v = 0, somme = 0, nb = 0;
+    int decalage = 0;
+    if (*limite >= 2) {
+        nb = 1;
+        somme = 2;
+        if (texte) fprintf(texte, "2\n");
+    }
+
+    ssize_t n;
+    while ((n = read(fd, tampon, FLUX_TAMPON_LECTURE)) > 0) {
+        stats->nb_octets += (uint64_t)n;
+        for (ssize_t i = 0; i < n; i++) {
+            uint8_t o = tampon[i];
+            v |= (uint64_t)(o & 0x7F) << decalage;
+            if (o & 0x80) {
+                decalage += 7;
+                continue;
+            }
+            p += 2 * v;
+            somme += p;
+            nb++;
+            if (texte) fprintf(texte, "%llu\n", (unsigned long long)p);
+            v = 0;
+            decalage = 0;
+        }
+    }
+    free(tampon);
+
+    stats->nb_premiers = nb;
+    stats->somme = somme;
+    stats->dernier = (p > 1) ? p : (nb ? 2 : 0);
+    if (n < 0 || decalage != 0) {
+        fprintf(stderr, "Erreur: flux tronqué\n");
+        return -1;
+    }
+    return 0;
+}
+
+// ============================================================================
+// RÉFÉRENCE TEXTE ET DÉMO
+// ============================================================================
+
+// Comme afficher_premiers: un fprintf par premier
+static double ecrire_texte(const char *chemin, uint64_t n, uint64_t *nb_octets) {
+    FILE *f = fopen(chemin, "w");
+    if (!f) return -1;
+    double start = omp_get_wtime();
+    size_t nb_base;
+    uint32_t *base = crible_premiers_base((uint32_t)crible_isqrt(n), &nb_base);
+    uint64_t *bits = (uint64_t*)malloc(CRIBLE_SEGMENT_OCTETS);
+    fprintf(f, "2\n");
+    for (uint64_t lo = 0; lo <= n; lo += CRIBLE_SEGMENT_NOMBRES) {
+        uint64_t hi = (lo + CRIBLE_SEGMENT_NOMBRES < n + 1) ? lo + CRIBLE_SEGMENT_NOMBRES : n + 1;
+        crible_segment_impairs(base, nb_base, lo, hi, bits);
+        for (size_t j = 0; j < crible_nb_bits(lo, hi); j++) {
+            if ((bits[j >> 6] >> (j & 63)) & 1) {
+                fprintf(f, "%llu\n", (unsigned long long)(lo + 2 * j + 1));
+            }
+        }
+    }
+    *nb_octets = (uint64_t)ftell(f);
+    fclose(f);
+    double temps = omp_get_wtime() - start;
+    free(bits);
+    free(base);
+    return temps;
+}
+
+static int ouvrir_sortie(const char *chemin) {
+    if (strcmp(chemin, "-") == 0) return STDOUT_FILENO;
+    return open(chemin, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+}
+
+static int ouvrir_entree(const char *chemin) {
+    if (strcmp(chemin, "-") == 0) return STDIN_FILENO;
+    return open(chemin, O_RDONLY);
+}
+
+static void afficher_stats(FILE *f, const char *nom, const FluxStats *s, double temps) {
+    fprintf(f, "   %-12s %12llu premiers | %8.2f Mo | %.3f octets/premier | %.4f s | %7.2f M premiers/s\n",
+            nom, (unsigned long long)s->nb_premiers, s->nb_octets / 1e6,
+            s->nb_premiers ? (double)s->nb_octets / s->nb_premiers : 0.0, temps, s->nb_premiers / temps * 1e-6);
+}
+
+static int demo(uint64_t n) {
+    int max_threads = omp_get_max_threads();
+    int erreurs = 0;
+
+    printf("1. ÉCRITURE DES PREMIERS <= %llu DANS %s\n", (unsigned long long)n, FLUX_FICHIER_DEFAUT);
+    FluxStats ecrit, lu;
+    for (int t = 1; t <= max_threads * 2; t *= 2) {
+        int fd = ouvrir_sortie(FLUX_FICHIER_DEFAUT);
+        if (fd < 0) {
+            fprintf(stderr, "Erreur: Impossible de créer %s\n", FLUX_FICHIER_DEFAUT);
+            return 1;
+        }
+        double start = omp_get_wtime();
+        int ok = flux_ecrire_premiers(fd, n, t, &ecrit) == 0;
+        close(fd);
+        double temps = omp_get_wtime() - start;
+        if (!ok) return 1;
+        char nom[32];
+        snprintf(nom, sizeof(nom), "%d threads", t);
+        afficher_stats(stdout, nom, &ecrit, temps);
+    }
+    printf("\n");
+
+    printf("2. RELECTURE ET VÉRIFICATION\n");
+    int fd = ouvrir_entree(FLUX_FICHIER_DEFAUT);
+    uint64_t limite;
+    double start = omp_get_wtime();
+    if (fd < 0 || flux_decoder(fd, &lu, &limite, NULL) != 0) return 1;
+    double temps = omp_get_wtime() - start;
+    close(fd);
+    afficher_stats(stdout, "Décodage", &lu, temps);
+
+    uint64_t attendu = count_primes_crible_segmente(n, max_threads);
+    int ok = lu.nb_premiers == attendu && lu.nb_premiers == ecrit.nb_premiers &&
+             lu.somme == ecrit.somme && lu.nb_octets == ecrit.nb_octets && limite == n;
+    if (!ok) erreurs++;
+    printf("   pi(%llu) = %llu (crible.h: %llu) | dernier: %llu | somme de contrôle %s\n\n",
+           (unsigned long long)n, (unsigned long long)lu.nb_premiers,
+           (unsigned long long)attendu, (unsigned long long)lu.dernier,
+           ok ? "✓" : "✗");
+
+    uint64_t n_texte = (n < 100000000) ? n : 100000000;
+    printf("3. RÉFÉRENCE: UN fprintf PAR PREMIER (comme afficher_premiers), N = %llu\n",
+           (unsigned long long)n_texte);
+    uint64_t octets_texte = 0;
+    double temps_texte = ecrire_texte("premiers.txt", n_texte, &octets_texte);
+    if (temps_texte < 0) {
+        fprintf(stderr, "Erreur: Impossible de créer premiers.txt\n");
+        return 1;
+    }
+    int fd_bin = ouvrir_sortie(FLUX_FICHIER_DEFAUT);
+    if (fd_bin < 0) {
+        fprintf(stderr, "Erreur: Impossible de créer %s\n", FLUX_FICHIER_DEFAUT);
+        return 1;
+    }
+    start = omp_get_wtime();
+    int ok_bin = flux_ecrire_premiers(fd_bin, n_texte, max_threads, &ecrit) == 0;
+    double temps_bin = omp_get_wtime() - start;
+    close(fd_bin);
+    if (!ok_bin) return 1;
+    FluxStats texte = {ecrit.nb_premiers, octets_texte, 0, 0};
+    afficher_stats(stdout, "Texte", &texte, temps_texte);
+    afficher_stats(stdout, "Binaire", &ecrit, temps_bin);
+    printf("   Binaire: %.1fx plus rapide, %.1fx plus compact\n",
+           temps_texte / temps_bin, (double)octets_texte / ecrit.nb_octets);
+    remove("premiers.txt");
+    remove(FLUX_FICHIER_DEFAUT);
+    return erreurs;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc > 2 && strcmp(argv[1], "ecrire") == 0) {
+        uint64_t n = (uint64_t)strtod(argv[2], NULL);
+        const char *chemin = (argc > 3) ? argv[3] : FLUX_FICHIER_DEFAUT;
+        int fd = ouvrir_sortie(chemin);
+        if (fd < 0) {
+            fprintf(stderr, "Erreur: Impossible de créer %s\n", chemin);
+            return 1;
+        }
+        FluxStats s;
+        double start = omp_get_wtime();
+        int ok = flux_ecrire_premiers(fd, n, omp_get_max_threads(), &s) == 0;
+        double temps = omp_get_wtime() - start;
+        if (fd != STDOUT_FILENO) close(fd);
+        if (!ok) {
+            fprintf(stderr, "Erreur: écriture interrompue\n");
+            return 1;
+        }
+        // Les statistiques vont sur stderr: stdout peut être le flux lui-même
+        afficher_stats(stderr, "Écriture", &s, temps);
+        return 0;
+    }
+
+    if (argc > 1 && (strcmp(argv[1], "lire") == 0 || strcmp(argv[1], "texte") == 0)) {
+        int afficher = (strcmp(argv[1], "texte") == 0);
+        const char *chemin = (argc > 2) ? argv[2] : FLUX_FICHIER_DEFAUT;
+        int fd = ouvrir_entree(chemin);
+        if (fd < 0) {
+            fprintf(stderr, "Erreur: Impossible d'ouvrir %s\n", chemin);
+            return 1;
+        }
+        FluxStats s;
+        uint64_t limite;
+        double start = omp_get_wtime();
+        int ok = flux_decoder(fd, &s, &limite, afficher ? stdout : NULL) == 0;
+        double temps = omp_get_wtime() - start;
+        if (fd != STDIN_FILENO) close(fd);
+        if (!ok) return 1;
+        if (!afficher) {
+            afficher_stats(stdout, "Lecture", &s, temps);
+            printf("   Limite: %llu | Dernier premier: %llu | Somme (mod 2^64): %llu\n",
+                   (unsigned long long)limite, (unsigned long long)s.dernier,
+                   (unsigned long long)s.somme);
+        }
+        return 0;
+    }
+
+    printf("================================================================================\n");
+    printf("  FLUX DE PREMIERS: export binaire (écarts + varint) en parallèle\n");
+    printf("================================================================================\n\n");
+
+    uint64_t n = (argc > 1) ? (uint64_t)strtod(argv[1], NULL) : 1000000000ull;
+    int erreurs = demo(n);
+
+    printf("\n================================================================================\n");
+    printf("ANALYSE\n");
+    printf("================================================================================\n");
+    printf("- Presque tous les écarts sont < 256 (un octet): ~1 octet par premier\n");
+    printf("- Le crible et l'encodage sont parallèles, seule l'écriture est ordonnée\n");
+    printf("- Un writev par tranche: peu d'appels système, aucune copie du préfixe\n");
+    printf("- Le texte coûte ~10 octets par premier et un formatage par nombre\n");
+
+    return erreurs != 0;
+}
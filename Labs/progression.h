@@ -0,0 +1,194 @@
+/*
+ * PROGRESSION: Avancement d'une boucle parallèle (débit, temps restant)
+ *
+ * Bibliothèque "header-only" (C11 + pthreads). Pour suivre un balayage de
+ * plusieurs heures sans ralentir la boucle:
+ *
+ * - Les workers comptent dans un compteur réparti (compteurs.h): une case
+ *   par thread sur sa propre ligne de cache, écriture sans lock
+ * - Un thread moniteur (pthread, hors de l'équipe OpenMP) se réveille
+ *   toutes les "periode" secondes, additionne les cases et affiche:
+ *
+ *     [crible 1e10]  45.2% | 2758/6104 | 1.23e+03 /s | écoulé 00:01:23 | reste ~00:01:41
+ *
+ * Le temps restant utilise un débit lissé (moyenne exponentielle) pour
+ * suivre les boucles dont la vitesse change (schedule dynamic, tailles
+ * variables). Sortie sur stderr par défaut: stdout reste propre pour les
+ * CSV. Sur un terminal la ligne est réécrite (\r), sinon une ligne par
+ * mesure (fichier de log).
+ *
+ * Coût pour les workers: un load + un store sur une ligne privée par
+ * appel; appeler progression_avancer par ligne, segment ou bloc, pas par
+ * élément.
+ *
+ * Utilisation:
+ *
+ *   Progression p;
+ *   progression_demarrer(&p, "matrice", n, omp_get_max_threads(), 1.0);
+ *   #pragma omp parallel for
+ *   for (int i = 0; i < n; i++) {
+ *       ... ligne i ...
+ *       progression_avancer(&p, omp_get_thread_num(), 1);
+ *   }
+ *   progression_terminer(&p);
+ *
+ * Compilation: gcc -fopenmp -O2 ... -pthread
+ */
+
+#ifndef PROGRESSION_H
+#define PROGRESSION_H
+
+#include <stdio.h>
+#include <time.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "compteurs.h"
+
+#define PROGRESSION_LISSAGE 0.3          // Poids de la dernière mesure de débit
+
+typedef struct {
+    CompteurReparti fait;
+    long total;                  // <= 0: inconnu (pas de pourcentage ni de reste)
+    const char *libelle;
+    double periode;              // Secondes entre deux affichages
+    FILE *sortie;
+    int terminal;                // Ligne réécrite avec \r
+
+    pthread_t moniteur;
+    pthread_mutex_t verrou;
+    pthread_cond_t reveil;
+    int arreter;
+
+    double t0;
+    long fait_precedent;         // État du moniteur
+    double t_precedent;
+    double debit_lisse;
+} Progression;
+
+static inline double progression_secondes(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static inline void progression_duree(char *texte, size_t taille, double secondes) {
+    long s = (secondes > 0) ? (long)(secondes + 0.5) : 0;
+    snprintf(texte, taille, "%02ld:%02ld:%02ld", s / 3600, s / 60 % 60, s % 60);
+}
+
+static inline void progression_afficher(Progression *p, long fait, double maintenant, int final) {
+    double ecoule = maintenant - p->t0;
+    char texte_ecoule[32], texte_reste[32];
+    progression_duree(texte_ecoule, sizeof(texte_ecoule), ecoule);
+
+    fprintf(p->sortie, "%s[%s] ", p->terminal ? "\r" : "", p->libelle);
+    if (p->total > 0) {
+        fprintf(p->sortie, "%5.1f%% | %ld/%ld", 100.0 * fait / p->total, fait, p->total);
+    } else {
+        fprintf(p->sortie, "%ld", fait);
+    }
+    if (final) {
+        fprintf(p->sortie, " | %.3g /s | terminé en %s\n",
+                (ecoule > 0) ? fait / ecoule : 0.0, texte_ecoule);
+    } else {
+        fprintf(p->sortie, " | %.3g /s | écoulé %s", p->debit_lisse, texte_ecoule);
+        if (p->total > 0 && p->debit_lisse > 0) {
+            progression_duree(texte_reste, sizeof(texte_reste),
+                              (p->total - fait) / p->debit_lisse);
+            fprintf(p->sortie, " | reste ~%s", texte_reste);
+        }
+        fprintf(p->sortie, p->terminal ? "   " : "\n");
+    }
+    fflush(p->sortie);
+}
+
+static void *progression_boucle_moniteur(void *arg) {
+    Progression *p = (Progression*)arg;
+    pthread_mutex_lock(&p->verrou);
+    while (!p->arreter) {
+        struct timespec echeance;
+        clock_gettime(CLOCK_MONOTONIC, &echeance);
+        long ns = echeance.tv_nsec + (long)((p->periode - (long)p->periode) * 1e9);
+        echeance.tv_sec += (time_t)p->periode + ns / 1000000000L;
+        echeance.tv_nsec = ns % 1000000000L;
+        while (!p->arreter &&
+               pthread_cond_timedwait(&p->reveil, &p->verrou, &echeance) == 0) {
+            // Réveil anticipé (arrêt ou réveil parasite)
+        }
+        if (p->arreter) break;
+
+        double maintenant = progression_secondes();
+        long fait = compteur_reparti_lire(&p->fait);
+        double debit = (fait - p->fait_precedent) / (maintenant - p->t_precedent);
+        p->debit_lisse = (p->debit_lisse == 0.0)
+                             ? debit
+                             : PROGRESSION_LISSAGE * debit +
+                                   (1.0 - PROGRESSION_LISSAGE) * p->debit_lisse;
+        p->fait_precedent = fait;
+        p->t_precedent = maintenant;
+        progression_afficher(p, fait, maintenant, 0);
+    }
+    pthread_mutex_unlock(&p->verrou);
+    return NULL;
+}
+
+// nb_threads: nombre de cases (threads qui appellent progression_avancer)
+static inline int progression_demarrer(Progression *p, const char *libelle, long total,
+                                       int nb_threads, double periode) {
+    compteur_reparti_init(&p->fait, nb_threads);
+    p->total = total;
+    p->libelle = libelle;
+    p->periode = (periode > 0) ? periode : 1.0;
+    p->sortie = stderr;
+    p->terminal = isatty(fileno(stderr));
+    p->arreter = 0;
+    p->t0 = p->t_precedent = progression_secondes();
+    p->fait_precedent = 0;
+    p->debit_lisse = 0.0;
+
+    pthread_condattr_t attributs;
+    pthread_condattr_init(&attributs);
+    pthread_condattr_setclock(&attributs, CLOCK_MONOTONIC);
+    pthread_cond_init(&p->reveil, &attributs);
+    pthread_condattr_destroy(&attributs);
+    pthread_mutex_init(&p->verrou, NULL);
+
+    if (pthread_create(&p->moniteur, NULL, progression_boucle_moniteur, p) != 0) {
+        fprintf(stderr, "Erreur: Impossible de lancer le thread de progression\n");
+        pthread_cond_destroy(&p->reveil);
+        pthread_mutex_destroy(&p->verrou);
+        compteur_reparti_liberer(&p->fait);
+        return -1;
+    }
+    return 0;
+}
+
+static inline void progression_avancer(Progression *p, int id, long delta) {
+    compteur_reparti_ajouter(&p->fait, id, delta);
+}
+
+// Même chose sous forme de rappel, pour les noyaux qui acceptent un
+// suivi optionnel sans dépendre de ce fichier (crible.h, matrix lab/matrix.h):
+//   count_primes_crible_segmente_suivi(n, t, progression_rappel, &p);
+static inline void progression_rappel(void *p, int id, long delta) {
+    progression_avancer((Progression*)p, id, delta);
+}
+
+// Arrête le moniteur, affiche la ligne finale; retourne la durée (s)
+static inline double progression_terminer(Progression *p) {
+    pthread_mutex_lock(&p->verrou);
+    p->arreter = 1;
+    pthread_cond_signal(&p->reveil);
+    pthread_mutex_unlock(&p->verrou);
+    pthread_join(p->moniteur, NULL);
+
+    double maintenant = progression_secondes();
+    progression_afficher(p, compteur_reparti_lire(&p->fait), maintenant, 1);
+
+    pthread_cond_destroy(&p->reveil);
+    pthread_mutex_destroy(&p->verrou);
+    compteur_reparti_liberer(&p->fait);
+    return maintenant - p->t0;
+}
+
+#endif
@@ -0,0 +1,335 @@
+/*
+ * REDUCTIONS: Réductions parallèles définies par l'utilisateur
+ *
+ * Bibliothèque "header-only" construite sur "#pragma omp declare reduction"
+ * avec des accumulateurs de type structure.
+ *
+ * Réductions disponibles (tableaux de double):
+ * 1. minmax   - minimum et maximum en une seule passe
+ * 2. argmin / argmax - valeur ET indice (le plus petit indice en cas d'égalité)
+ * 3. welford  - effectif, moyenne et somme des carrés des écarts (variance)
+ * 4. topk     - les REDUCTIONS_TOPK plus grandes valeurs avec leurs indices
+ * 5. resume   - min, max, argmin, argmax, moyenne et variance en une passe
+ *
+ * Principe commun: chaque thread remplit sa copie privée (initializer),
+ * OpenMP combine les copies deux à deux (combiner). Le tableau est parcouru
+ * par blocs de REDUCTIONS_BLOC éléments: pour Welford, le bloc est relu
+ * depuis le cache L1 (moyenne puis écarts), la mémoire n'est lue qu'une fois.
+ *
+ * Utilisation directe dans une boucle:
+ *
+ *   MinMax mm = minmax_neutre();
+ *   #pragma omp parallel for reduction(minmax:mm)
+ *   for (long i = 0; i < n; i++) mm = minmax_ajouter(mm, a[i]);
+ *
+ * ou via les fonctions reduire_*(a, n, num_threads).
+ */
+
+#ifndef REDUCTIONS_H
+#define REDUCTIONS_H
+
+#include <math.h>
+#include <omp.h>
+
+#ifndef REDUCTIONS_TOPK
+#define REDUCTIONS_TOPK 8
+#endif
+
+// Taille de bloc pour les passes en cache (4096 doubles = 32 Ko = L1)
+#define REDUCTIONS_BLOC 4096
+
+// ============================================================================
+// 1. MIN + MAX
+// ============================================================================
+
+typedef struct {
+    double min;
+    double max;
+} MinMax;
+
+static inline MinMax minmax_neutre(void) {
+    MinMax r = {INFINITY, -INFINITY};
+    return r;
+}
+
+static inline MinMax minmax_ajouter(MinMax r, double x) {
+    r.min = (x < r.min) ? x : r.min;
+    r.max = (x > r.max) ? x : r.max;
+    return r;
+}
+
+static inline MinMax minmax_combiner(MinMax a, MinMax b) {
+    a.min = (b.min < a.min) ? b.min : a.min;
+    a.max = (b.max > a.max) ? b.max : a.max;
+    return a;
+}
+
+#pragma omp declare reduction(minmax : MinMax : omp_out = minmax_combiner(omp_out, omp_in)) \
+    initializer(omp_priv = minmax_neutre())
+
+// ============================================================================
+// 2. ARGMIN / ARGMAX
+// ============================================================================
+
+typedef struct {
+    double valeur;
+    long indice;     // -1 tant qu'aucun élément n'a été vu
+} ArgVal;
+
+static inline ArgVal argmin_neutre(void) {
+    ArgVal r = {INFINITY, -1};
+    return r;
+}
+
+static inline ArgVal argmax_neutre(void) {
+    ArgVal r = {-INFINITY, -1};
+    return r;
+}
+
+// À égalité de valeur, le plus petit indice gagne: résultat indépendant
+// du nombre de threads et de l'ordre de combinaison
+static inline ArgVal argmin_combiner(ArgVal a, ArgVal b) {
+    if (b.indice < 0) return a;
+    if (a.indice < 0 || b.valeur < a.valeur ||
+        (b.valeur == a.valeur && b.indice < a.indice)) return b;
+    return a;
+}
+
+static inline ArgVal argmax_combiner(ArgVal a, ArgVal b) {
+    if (b.indice < 0) return a;
+    if (a.indice < 0 || b.valeur > a.valeur ||
+        (b.valeur == a.valeur && b.indice < a.indice)) return b;
+    return a;
+}
+
+#pragma omp declare reduction(argmin : ArgVal : omp_out = argmin_combiner(omp_out, omp_in)) \
+    initializer(omp_priv = argmin_neutre())
+#pragma omp declare reduction(argmax : ArgVal : omp_out = argmax_combiner(omp_out, omp_in)) \
+    initializer(omp_priv = argmax_neutre())
+
+// ============================================================================
+// 3. WELFORD: MOYENNE ET VARIANCE
+// ============================================================================
+
+typedef struct {
+    long n;
+    double moyenne;
+    double m2;       // Somme des (x - moyenne)²
+} Welford;
+
+static inline Welford welford_neutre(void) {
+    Welford r = {0, 0.0, 0.0};
+    return r;
+}
+
+static inline Welford welford_ajouter(Welford r, double x) {
+    r.n++;
+    double delta = x - r.moyenne;
+    r.moyenne += delta / r.n;
+    r.m2 += delta * (x - r.moyenne);
+    return r;
+}
+
+// Formule de Chan et al.: fusion de deux ensembles disjoints
+static inline Welford welford_combiner(Welford a, Welford b) {
+    if (b.n == 0) return a;
+    if (a.n == 0) return b;
+    long n = a.n + b.n;
+    double delta = b.moyenne - a.moyenne;
+    a.moyenne += delta * b.n / n;
+    a.m2 += b.m2 + delta * delta * ((double)a.n * b.n / n);
+    a.n = n;
+    return a;
+}
+
+// Bloc en cache: moyenne exacte du bloc, puis écarts (2 lectures L1)
+static inline Welford welford_bloc(const double *a, long n) {
+    double somme = 0.0;
+    #pragma omp simd reduction(+:somme)
+    for (long i = 0; i < n; i++) somme += a[i];
+    double moyenne = somme / n;
+
+    double m2 = 0.0;
+    #pragma omp simd reduction(+:m2)
+    for (long i = 0; i < n; i++) {
+        double d = a[i] - moyenne;
+        m2 += d * d;
+    }
+    Welford r = {n, moyenne, m2};
+    return r;
+}
+
+static inline double welford_variance(Welford w) {
+    return (w.n > 1) ? w.m2 / (w.n - 1) : 0.0;   // Variance d'échantillon
+}
+
+#pragma omp declare reduction(welford : Welford : omp_out = welford_combiner(omp_out, omp_in)) \
+    initializer(omp_priv = welford_neutre())
+
+// ============================================================================
+// 4. TOP-K
+// ============================================================================
+
+typedef struct {
+    int nb;
+    double valeur[REDUCTIONS_TOPK];   // Triées par ordre décroissant
+    long indice[REDUCTIONS_TOPK];
+} TopK;
+
+static inline TopK topk_neutre(void) {
+    TopK r;
+    r.nb = 0;
+    return r;
+}
+
+// (v, i) passe avant (w, j): plus grande valeur, puis plus petit indice
+static inline int topk_avant(double v, long i, double w, long j) {
+    return v > w || (v == w && i < j);
+}
+
+static inline void topk_inserer(TopK *r, double x, long i) {
+    if (r->nb == REDUCTIONS_TOPK &&
+        !topk_avant(x, i, r->valeur[REDUCTIONS_TOPK - 1], r->indice[REDUCTIONS_TOPK - 1])) {
+        return;  // Cas le plus fréquent: une seule comparaison
+    }
+    int k = (r->nb < REDUCTIONS_TOPK) ? r->nb++ : REDUCTIONS_TOPK - 1;
+    while (k > 0 && topk_avant(x, i, r->valeur[k - 1], r->indice[k - 1])) {
+        r->valeur[k] = r->valeur[k - 1];
+        r->indice[k] = r->indice[k - 1];
+        k--;
+    }
+    r->valeur[k] = x;
+    r->indice[k] = i;
+}
+
+// Fusion de deux listes triées
+static inline TopK topk_combiner(TopK a, TopK b) {
+    TopK r;
+    int ia = 0, ib = 0;
+    r.nb = 0;
+    while (r.nb < REDUCTIONS_TOPK && (ia < a.nb || ib < b.nb)) {
+        if (ib >= b.nb || (ia < a.nb &&
+            topk_avant(a.valeur[ia], a.indice[ia], b.valeur[ib], b.indice[ib]))) {
+            r.valeur[r.nb] = a.valeur[ia];
+            r.indice[r.nb++] = a.indice[ia++];
+        } else {
+            r.valeur[r.nb] = b.valeur[ib];
+            r.indice[r.nb++] = b.indice[ib++];
+        }
+    }
+    return r;
+}
+
+#pragma omp declare reduction(topk : TopK : omp_out = topk_combiner(omp_out, omp_in)) \
+    initializer(omp_priv = topk_neutre())
+
+// ============================================================================
+// 5. RÉSUMÉ: TOUT EN UNE PASSE
+// ============================================================================
+
+typedef struct {
+    ArgVal min;
+    ArgVal max;
+    Welford stats;
+} Resume;
+
+static inline Resume resume_neutre(void) {
+    Resume r = {argmin_neutre(), argmax_neutre(), welford_neutre()};
+    return r;
+}
+
+static inline Resume resume_combiner(Resume a, Resume b) {
+    a.min = argmin_combiner(a.min, b.min);
+    a.max = argmax_combiner(a.max, b.max);
+    a.stats = welford_combiner(a.stats, b.stats);
+    return a;
+}
+
+#pragma omp declare reduction(resume : Resume : omp_out = resume_combiner(omp_out, omp_in)) \
+    initializer(omp_priv = resume_neutre())
+
+// ============================================================================
+// FONCTIONS SUR TABLEAUX
+// ============================================================================
+
+static inline long reductions_nb_blocs(long n) {
+    return (n + REDUCTIONS_BLOC - 1) / REDUCTIONS_BLOC;
+}
+
+static inline MinMax reduire_minmax(const double *a, long n, int num_threads) {
+    MinMax r = minmax_neutre();
+    #pragma omp parallel for reduction(minmax:r) schedule(static) num_threads(num_threads)
+    for (long i = 0; i < n; i++) {
+        r = minmax_ajouter(r, a[i]);
+    }
+    return r;
+}
+
+static inline ArgVal reduire_argmin(const double *a, long n, int num_threads) {
+    ArgVal r = argmin_neutre();
+    #pragma omp parallel for reduction(argmin:r) schedule(static) num_threads(num_threads)
+    for (long i = 0; i < n; i++) {
+        if (a[i] < r.valeur) {
+            r.valeur = a[i];
+            r.indice = i;
+        }
+    }
+    return r;
+}
+
+static inline ArgVal reduire_argmax(const double *a, long n, int num_threads) {
+    ArgVal r = argmax_neutre();
+    #pragma omp parallel for reduction(argmax:r) schedule(static) num_threads(num_threads)
+    for (long i = 0; i < n; i++) {
+        if (a[i] > r.valeur) {
+            r.valeur = a[i];
+            r.indice = i;
+        }
+    }
+    return r;
+}
+
+static inline Welford reduire_welford(const double *a, long n, int num_threads) {
+    Welford r = welford_neutre();
+    long nb_blocs = reductions_nb_blocs(n);
+    #pragma omp parallel for reduction(welford:r) schedule(static) num_threads(num_threads)
+    for (long b = 0; b < nb_blocs; b++) {
+        long debut = b * REDUCTIONS_BLOC;
+        long taille = (debut + REDUCTIONS_BLOC < n) ? REDUCTIONS_BLOC : n - debut;
+        r = welford_combiner(r, welford_bloc(a + debut, taille));
+    }
+    return r;
+}
+
+static inline TopK reduire_topk(const double *a, long n, int num_threads) {
+    TopK r = topk_neutre();
+    #pragma omp parallel for reduction(topk:r) schedule(static) num_threads(num_threads)
+    for (long i = 0; i < n; i++) {
+        topk_inserer(&r, a[i], i);
+    }
+    return r;
+}
+
+static inline Resume reduire_resume(const double *a, long n, int num_threads) {
+    Resume r = resume_neutre();
+    long nb_blocs = reductions_nb_blocs(n);
+    #pragma omp parallel for reduction(resume:r) schedule(static) num_threads(num_threads)
+    for (long b = 0; b < nb_blocs; b++) {
+        long debut = b * REDUCTIONS_BLOC;
+        long taille = (debut + REDUCTIONS_BLOC < n) ? REDUCTIONS_BLOC : n - debut;
+        const double *bloc = a + debut;
+
+        // Le bloc est chargé une fois depuis la mémoire, relu depuis L1
+        ArgVal mn = r.min, mx = r.max;
+        for (long i = 0; i < taille; i++) {
+            if (bloc[i] < mn.valeur) { mn.valeur = bloc[i]; mn.indice = debut + i; }
+            if (bloc[i] > mx.valeur) { mx.valeur = bloc[i]; mx.indice = debut + i; }
+        }
+        r.min = mn;
+        r.max = mx;
+        r.stats = welford_combiner(r.stats, welford_bloc(bloc, taille));
+    }
+    return r;
+}
+
+#endif
@@ -0,0 +1,206 @@
+/*
+ * SCAN: Sommes préfixes parallèles (inclusives et exclusives)
+ *
+ * Bibliothèque "header-only". Brique de base pour la compaction, les
+ * histogrammes (positions de sortie) et l'équilibrage de charge.
+ *
+ *   inclusif: out[i] = in[0] + ... + in[i]
+ *   exclusif: out[i] = in[0] + ... + in[i-1]      (out[0] = 0)
+ *
+ * Trois algorithmes, générés pour int64, float et double:
+ *
+ * 1. DEUX PASSES (reduce-then-scan), un bloc contigu par thread:
+ *      passe 1: chaque thread somme son bloc           -> partiels[t]
+ *      (un thread fait la somme préfixe des partiels)
+ *      passe 2: chaque thread scanne son bloc à partir de partiels[t]
+ *    Trafic mémoire: 2 lectures + 1 écriture
+ *
+ * 2. UNE PASSE AVEC REGARD EN ARRIÈRE (decoupled look-back):
+ *    Le tableau est découpé en tuiles de SCAN_TUILE éléments, prises dans
+ *    l'ordre par un compteur atomique. Pour chaque tuile k:
+ *      - somme locale, publiée avec l'état AGREGAT
+ *      - regard en arrière: on additionne les agrégats des tuiles k-1,
+ *        k-2, ... jusqu'à trouver une tuile à l'état PREFIXE
+ *      - préfixe inclusif de la tuile publié (état PREFIXE)
+ *      - scan de la tuile, encore en cache
+ *    Trafic mémoire: 1 lecture + 1 écriture
+ *
+ * 3. DIRECTIVE "omp scan" d'OpenMP 5 (reduction(inscan, +:s)), pour comparer
+ *
+ * in et out ne doivent pas se chevaucher. Pour les flottants, l'ordre des
+ * additions diffère entre algorithmes: les arrondis peuvent différer.
+ *
+ * API (nom = int64 | float | double):
+ *   scan_sequentiel_<nom>(in, out, n, mode)
+ *   scan_deux_passes_<nom>(in, out, n, mode, num_threads)
+ *   scan_lookback_<nom>(in, out, n, mode, num_threads)
+ *   scan_omp_<nom>(in, out, n, mode, num_threads)
+ * avec mode = SCAN_INCLUSIF ou SCAN_EXCLUSIF.
+ */
+
+#ifndef SCAN_H
+#define SCAN_H
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <sched.h>
+#include <omp.h>
+
+#define SCAN_INCLUSIF 1
+#define SCAN_EXCLUSIF 0
+
+// Tuile du regard en arrière: 8192 éléments (64 Ko en double, tient en L2)
+#ifndef SCAN_TUILE
+#define SCAN_TUILE 8192
+#endif
+
+#define SCAN_LIGNE_CACHE 64
+
+// États d'une tuile
+#define SCAN_VIDE 0
+#define SCAN_AGREGAT 1
+#define SCAN_PREFIXE 2
+
+// Attente active, puis on cède le cœur (machines surchargées)
+#define SCAN_ATTENTE_MAX 1024
+
+#define DEFINIR_SCAN(nom, type)                                                 \
+                                                                                \
+static inline void scan_local_##nom(const type *in, type *out, long n,          \
+                                    type depart, int mode) {                    \
+    type acc = depart;                                                          \
+    if (mode == SCAN_INCLUSIF) {                                                \
+        for (long i = 0; i < n; i++) {                                          \
+            acc += in[i];                                                       \
+            out[i] = acc;                                                       \
+        }                                                                       \
+    } else {                                                                    \
+        for (long i = 0; i < n; i++) {                                          \
+            type x = in[i];                                                     \
+            out[i] = acc;                                                       \
+            acc += x;                                                           \
+        }                                                                       \
+    }                                                                           \
+}                                                                               \
+                                                                                \
+static inline type scan_somme_##nom(const type *in, long n) {                   \
+    type s = 0;                                                                 \
+    _Pragma("omp simd reduction(+:s)")                                          \
+    for (long i = 0; i < n; i++) s += in[i];                                    \
+    return s;                                                                   \
+}                                                                               \
+                                                                                \
+static inline void scan_sequentiel_##nom(const type *in, type *out, long n,     \
+                                         int mode) {                            \
+    scan_local_##nom(in, out, n, 0, mode);                                      \
+}                                                                               \
+                                                                                \
+/* 1. Deux passes: somme par bloc, préfixe des partiels, scan par bloc */      \
+static inline void scan_deux_passes_##nom(const type *in, type *out, long n,    \
+                                          int mode, int num_threads) {          \
+    type *partiels = (type*)calloc(num_threads + 1, sizeof(type));              \
+    _Pragma("omp parallel num_threads(num_threads)")                            \
+    {                                                                           \
+        int t = omp_get_thread_num();                                           \
+        int nb = omp_get_num_threads();                                         \
+        long debut = n * t / nb;                                                \
+        long fin = n * (t + 1) / nb;                                            \
+        partiels[t + 1] = scan_somme_##nom(in + debut, fin - debut);            \
+        _Pragma("omp barrier")                                                  \
+        _Pragma("omp single")                                                   \
+        for (int k = 1; k <= nb; k++) partiels[k] += partiels[k - 1];           \
+        scan_local_##nom(in + debut, out + debut, fin - debut,                  \
+                         partiels[t], mode);                                    \
+    }                                                                           \
+    free(partiels);                                                             \
+}                                                                               \
+                                                                                \
+/* Descripteur de tuile, seul sur sa ligne de cache */                          \
+typedef struct {                                                                \
+    _Alignas(SCAN_LIGNE_CACHE) atomic_int etat;                                 \
+    type agregat;                                                               \
+    type prefixe;        /* Préfixe inclusif: tuiles 0..k */                    \
+} ScanTuile_##nom;                                                              \
+                                                                                \
+/* 2. Une passe: regard en arrière sur les tuiles précédentes */                \
+static inline void scan_lookback_##nom(const type *in, type *out, long n,       \
+                                       int mode, int num_threads) {             \
+    long nb_tuiles = (n + SCAN_TUILE - 1) / SCAN_TUILE;                         \
+    ScanTuile_##nom *tuiles = (ScanTuile_##nom*)aligned_alloc(                  \
+        SCAN_LIGNE_CACHE, (nb_tuiles + 1) * sizeof(ScanTuile_##nom));           \
+    for (long k = 0; k < nb_tuiles; k++) {                                      \
+        atomic_init(&tuiles[k].etat, SCAN_VIDE);                                \
+    }                                                                           \
+    atomic_long suivante;                                                       \
+    atomic_init(&suivante, 0);                                                  \
+                                                                                \
+    _Pragma("omp parallel num_threads(num_threads)")                            \
+    {                                                                           \
+        for (;;) {                                                              \
+            /* Tuiles prises dans l'ordre: la précédente est toujours */        \
+            /* déjà attribuée, l'attente ne peut pas bloquer */                 \
+            long k = atomic_fetch_add_explicit(&suivante, 1,                    \
+                                               memory_order_relaxed);           \
+            if (k >= nb_tuiles) break;                                          \
+            long debut = k * SCAN_TUILE;                                        \
+            long taille = (debut + SCAN_TUILE < n) ? SCAN_TUILE : n - debut;    \
+            type agregat = scan_somme_##nom(in + debut, taille);                \
+            type exclusif = 0;                                                  \
+                                                                                \
+            if (k > 0) {                                                        \
+                tuiles[k].agregat = agregat;                                    \
+                atomic_store_explicit(&tuiles[k].etat, SCAN_AGREGAT,            \
+                                      memory_order_release);                    \
+                for (long j = k - 1; ; j--) {                                   \
+                    int e, attente = 0;                                         \
+                    while ((e = atomic_load_explicit(&tuiles[j].etat,           \
+                                memory_order_acquire)) == SCAN_VIDE) {          \
+                        if (++attente == SCAN_ATTENTE_MAX) {                    \
+                            sched_yield();                                      \
+                            attente = 0;                                        \
+                        }                                                       \
+                    }                                                           \
+                    if (e == SCAN_PREFIXE) {                                    \
+                        exclusif += tuiles[j].prefixe;                          \
+                        break;                                                  \
+                    }                                                           \
+                    exclusif += tuiles[j].agregat;                              \
+                }                                                               \
+            }                                                                   \
+            tuiles[k].prefixe = exclusif + agregat;                             \
+            atomic_store_explicit(&tuiles[k].etat, SCAN_PREFIXE,                \
+                                  memory_order_release);                        \
+                                                                                \
+            scan_local_##nom(in + debut, out + debut, taille, exclusif, mode);  \
+        }                                                                       \
+    }                                                                           \
+    free(tuiles);                                                               \
+}                                                                               \
+                                                                                \
+/* 3. Directive scan d'OpenMP 5 */                                              \
+static inline void scan_omp_##nom(const type *in, type *out, long n,            \
+                                  int mode, int num_threads) {                  \
+    type s = 0;                                                                 \
+    if (mode == SCAN_INCLUSIF) {                                                \
+        _Pragma("omp parallel for simd reduction(inscan, +:s) num_threads(num_threads)") \
+        for (long i = 0; i < n; i++) {                                          \
+            s += in[i];                                                         \
+            _Pragma("omp scan inclusive(s)")                                    \
+            out[i] = s;                                                         \
+        }                                                                       \
+    } else {                                                                    \
+        _Pragma("omp parallel for simd reduction(inscan, +:s) num_threads(num_threads)") \
+        for (long i = 0; i < n; i++) {                                          \
+            out[i] = s;                                                         \
+            _Pragma("omp scan exclusive(s)")                                    \
+            s += in[i];                                                         \
+        }                                                                       \
+    }                                                                           \
+}
+
+DEFINIR_SCAN(int64, int64_t)
+DEFINIR_SCAN(float, float)
+DEFINIR_SCAN(double, double)
+
+#endif
@@ -0,0 +1,268 @@
+/*
+ * TRI: Tris parallèles de clés entières (uint32, uint64)
+ *
+ * Bibliothèque "header-only". Deux algorithmes:
+ *
+ * 1. TRI FUSION PAR TÂCHES (#pragma omp task)
+ *
+ *      tri(a, n):  tri(a[0..n/2])   tri(a[n/2..n])    <- 2 tâches
+ *                          \           /
+ *                      fusion parallèle               <- tâches aussi
+ *
+ *    - Sous TRI_SEUIL_TACHE éléments: introsort séquentiel (quicksort
+ *      médiane de 3, tri par tas si la récursion dégénère, insertion
+ *      sous TRI_SEUIL_INSERTION)
+ *    - Fusion parallèle: on coupe la plus longue suite en son milieu m,
+ *      on cherche la position de m dans l'autre (recherche binaire), et
+ *      les deux moitiés se fusionnent indépendamment
+ *    - Tampon de n éléments, utilisé en alternance (pas de recopie)
+ *
+ * 2. TRI PAR BASE LSD (radix), chiffres de 8 bits, du poids faible au fort
+ *
+ *    Pour chaque chiffre (4 passes en uint32, 8 en uint64), un bloc
+ *    contigu par thread:
+ *      a) chaque thread compte ses chiffres           -> comptes[chiffre][t]
+ *      b) somme préfixe exclusive de comptes (scan.h) -> position de départ
+ *         de chaque (chiffre, thread) dans la sortie
+ *      c) chaque thread range ses clés (tri stable)
+ *    Une passe où toutes les clés ont le même chiffre est sautée (clés de
+ *    faible amplitude dans un uint64).
+ *
+ * API (nom = u32 | u64):
+ *   tri_fusion_<nom>(a, n, num_threads)
+ *   tri_base_<nom>(a, n, num_threads)
+ *   tri_introsort_<nom>(a, n)                (séquentiel)
+ * Retournent 0, ou -1 si le tampon ne peut pas être alloué.
+ */
+
+#ifndef TRI_H
+#define TRI_H
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <omp.h>
+#include "scan.h"
+
+#define TRI_SEUIL_INSERTION 32
+#define TRI_SEUIL_TACHE 16384     // Éléments: en dessous, introsort séquentiel
+#define TRI_SEUIL_FUSION 16384    // Éléments: en dessous, fusion séquentielle
+
+#define TRI_BITS 8
+#define TRI_SEAUX (1 << TRI_BITS)
+
+#define DEFINIR_TRI(nom, type)                                                  \
+                                                                                \
+static inline void tri_insertion_##nom(type *a, long n) {                       \
+    for (long i = 1; i < n; i++) {                                              \
+        type x = a[i];                                                          \
+        long j = i - 1;                                                         \
+        while (j >= 0 && a[j] > x) {                                            \
+            a[j + 1] = a[j];                                                    \
+            j--;                                                                \
+        }                                                                       \
+        a[j + 1] = x;                                                           \
+    }                                                                           \
+}                                                                               \
+                                                                                \
+static inline void tri_tamiser_##nom(type *a, long racine, long fin) {          \
+    for (;;) {                                                                  \
+        long fils = 2 * racine + 1;                                             \
+        if (fils >= fin) return;                                                \
+        if (fils + 1 < fin && a[fils + 1] > a[fils]) fils++;                    \
+        if (a[racine] >= a[fils]) return;                                       \
+        type t = a[racine]; a[racine] = a[fils]; a[fils] = t;                   \
+        racine = fils;                                                          \
+    }                                                                           \
+}                                                                               \
+                                                                                \
+static inline void tri_tas_##nom(type *a, long n) {                             \
+    for (long i = n / 2 - 1; i >= 0; i--) tri_tamiser_##nom(a, i, n);           \
+    for (long fin = n - 1; fin > 0; fin--) {                                    \
+        type t = a[0]; a[0] = a[fin]; a[fin] = t;                               \
+        tri_tamiser_##nom(a, 0, fin);                                           \
+    }                                                                           \
+}                                                                               \
+                                                                                \
+static inline void tri_intro_rec_##nom(type *a, long n, int profondeur) {       \
+    while (n > TRI_SEUIL_INSERTION) {                                           \
+        if (profondeur-- == 0) {                                                \
+            tri_tas_##nom(a, n);                                                \
+            return;                                                             \
+        }                                                                       \
+        /* Médiane de 3 comme pivot, partition de Hoare */                      \
+        type x = a[0], y = a[n / 2], z = a[n - 1];                              \
+        type pivot = (x < y) ? ((y < z) ? y : (x < z) ? z : x)                  \
+                             : ((x < z) ? x : (y < z) ? z : y);                 \
+        long i = -1, j = n;                                                     \
+        for (;;) {                                                              \
+            do i++; while (a[i] < pivot);                                       \
+            do j--; while (a[j] > pivot);                                       \
+            if (i >= j) break;                                                  \
+            type t = a[i]; a[i] = a[j]; a[j] = t;                               \
+        }                                                                       \
+        /* Récursion sur la plus petite partie: pile en O(log n) */             \
+        if (j + 1 < n - j - 1) {                                                \
+            tri_intro_rec_##nom(a, j + 1, profondeur);                          \
+            a += j + 1;                                                         \
+            n -= j + 1;                                                         \
+        } else {                                                                \
+            tri_intro_rec_##nom(a + j + 1, n - j - 1, profondeur);              \
+            n = j + 1;                                                          \
+        }                                                                       \
+    }                                                                           \
+    tri_insertion_##nom(a, n);                                                  \
+}                                                                               \
+                                                                                \
+static inline void tri_introsort_##nom(type *a, long n) {                       \
+    int profondeur = 0;                                                         \
+    for (long k = n; k > 1; k >>= 1) profondeur += 2;                           \
+    tri_intro_rec_##nom(a, n, profondeur);                                      \
+}                                                                               \
+                                                                                \
+/* Premier indice i de a[0..n) tel que a[i] >= x */                             \
+static inline long tri_borne_inf_##nom(const type *a, long n, type x) {         \
+    long bas = 0, haut = n;                                                     \
+    while (bas < haut) {                                                        \
+        long milieu = bas + (haut - bas) / 2;                                   \
+        if (a[milieu] < x) bas = milieu + 1;                                    \
+        else haut = milieu;                                                     \
+    }                                                                           \
+    return bas;                                                                 \
+}                                                                               \
+                                                                                \
+static inline void tri_fusion_seq_##nom(const type *a, long na, const type *b,  \
+                                        long nb, type *out) {                   \
+    long i = 0, j = 0, k = 0;                                                   \
+    while (i < na && j < nb) out[k++] = (b[j] < a[i]) ? b[j++] : a[i++];        \
+    while (i < na) out[k++] = a[i++];                                           \
+    while (j < nb) out[k++] = b[j++];                                           \
+}                                                                               \
+                                                                                \
+/* Fusion parallèle de a[0..na) et b[0..nb) dans out */                         \
+static inline void tri_fusion_par_##nom(const type *a, long na, const type *b,  \
+                                        long nb, type *out) {                   \
+    if (na < nb) {                                                              \
+        const type *t = a; a = b; b = t;                                        \
+        long tn = na; na = nb; nb = tn;                                         \
+    }                                                                           \
+    if (na + nb <= TRI_SEUIL_FUSION) {                                          \
+        tri_fusion_seq_##nom(a, na, b, nb, out);                                \
+        return;                                                                 \
+    }                                                                           \
+    long ma = na / 2;                                                           \
+    long mb = tri_borne_inf_##nom(b, nb, a[ma]);                                \
+    out[ma + mb] = a[ma];                                                       \
+    _Pragma("omp task")                                                         \
+    tri_fusion_par_##nom(a, ma, b, mb, out);                                    \
+    tri_fusion_par_##nom(a + ma + 1, na - ma - 1, b + mb, nb - mb,              \
+                         out + ma + mb + 1);                                    \
+    _Pragma("omp taskwait")                                                     \
+}                                                                               \
+                                                                                \
+/* Trie a[0..n); le résultat est dans b si vers_b, sinon dans a */              \
+static inline void tri_fusion_rec_##nom(type *a, type *b, long n, int vers_b) { \
+    if (n <= TRI_SEUIL_TACHE) {                                                 \
+        tri_introsort_##nom(a, n);                                              \
+        if (vers_b) memcpy(b, a, n * sizeof(type));                             \
+        return;                                                                 \
+    }                                                                           \
+    long h = n / 2;                                                             \
+    /* Les moitiés sont triées dans l'autre tableau, puis fusionnées ici */     \
+    _Pragma("omp task")                                                         \
+    tri_fusion_rec_##nom(a, b, h, !vers_b);                                     \
+    tri_fusion_rec_##nom(a + h, b + h, n - h, !vers_b);                         \
+    _Pragma("omp taskwait")                                                     \
+    const type *src = vers_b ? a : b;                                           \
+    type *dst = vers_b ? b : a;                                                 \
+    tri_fusion_par_##nom(src, h, src + h, n - h, dst);                          \
+}                                                                               \
+                                                                                \
+static inline int tri_fusion_##nom(type *a, long n, int num_threads) {          \
+    if (n < 2) return 0;                                                        \
+    type *tampon = (type*)malloc(n * sizeof(type));                             \
+    if (!tampon) return -1;                                                     \
+    _Pragma("omp parallel num_threads(num_threads)")                            \
+    _Pragma("omp single")                                                       \
+    tri_fusion_rec_##nom(a, tampon, n, 0);                                      \
+    free(tampon);                                                               \
+    return 0;                                                                   \
+}                                                                               \
+                                                                                \
+static inline int tri_base_##nom(type *a, long n, int num_threads) {            \
+    if (n < 2) return 0;                                                        \
+    long nb_comptes = (long)TRI_SEAUX * num_threads;                            \
+    type *tampon = (type*)malloc(n * sizeof(type));                             \
+    int64_t *comptes = (int64_t*)malloc(nb_comptes * sizeof(int64_t));          \
+    int64_t *departs = (int64_t*)malloc(nb_comptes * sizeof(int64_t));          \
+    if (!tampon || !comptes || !departs) {                                      \
+        free(tampon);                                                           \
+        free(comptes);                                                          \
+        free(departs);                                                          \
+        return -1;                                                              \
+    }                                                                           \
+    type *resultat = a;                                                         \
+                                                                                \
+    _Pragma("omp parallel num_threads(num_threads)")                            \
+    {                                                                           \
+        int t = omp_get_thread_num();                                           \
+        int nb = omp_get_num_threads();                                         \
+        long debut = n * t / nb;                                                \
+        long fin = n * (t + 1) / nb;                                            \
+        /* Copies privées: chaque thread échange les siennes à chaque passe */  \
+        type *src = a, *dst = tampon;                                           \
+                                                                                \
+        for (int decalage = 0; decalage < (int)(8 * sizeof(type));              \
+             decalage += TRI_BITS) {                                            \
+            int64_t local[TRI_SEAUX] = {0};                                     \
+            for (long i = debut; i < fin; i++) {                                \
+                local[(src[i] >> decalage) & (TRI_SEAUX - 1)]++;                \
+            }                                                                   \
+            /* Disposition chiffre-majeur: le scan exclusif donne */            \
+            /* directement le départ de (chiffre, thread) dans la sortie */     \
+            for (int d = 0; d < TRI_SEAUX; d++) comptes[d * nb + t] = local[d]; \
+            _Pragma("omp barrier")                                              \
+            int saut = 0;                                                       \
+            _Pragma("omp single copyprivate(saut)")                             \
+            {                                                                   \
+                /* Un seul chiffre présent: passe inutile */                    \
+                int presents = 0;                                               \
+                for (int d = 0; d < TRI_SEAUX && presents < 2; d++) {           \
+                    int64_t total = 0;                                          \
+                    for (int k = 0; k < nb; k++) total += comptes[d * nb + k];  \
+                    presents += (total > 0);                                    \
+                }                                                               \
+                saut = (presents < 2);                                          \
+                if (!saut) {                                                    \
+                    scan_sequentiel_int64(comptes, departs, (long)TRI_SEAUX * nb, \
+                                          SCAN_EXCLUSIF);                       \
+                }                                                               \
+            }                                                                   \
+            if (saut) continue;                                                 \
+            int64_t position[TRI_SEAUX];                                        \
+            for (int d = 0; d < TRI_SEAUX; d++) position[d] = departs[d * nb + t]; \
+            for (long i = debut; i < fin; i++) {                                \
+                type x = src[i];                                                \
+                dst[position[(x >> decalage) & (TRI_SEAUX - 1)]++] = x;         \
+            }                                                                   \
+            _Pragma("omp barrier")                                              \
+            type *tmp = src; src = dst; dst = tmp;                              \
+        }                                                                       \
+        if (t == 0) resultat = src;                                             \
+    }                                                                           \
+                                                                                \
+    /* Nombre impair de passes effectuées: le résultat est dans le tampon */    \
+    if (resultat != a) {                                                        \
+        _Pragma("omp parallel for simd num_threads(num_threads)")               \
+        for (long i = 0; i < n; i++) a[i] = resultat[i];                        \
+    }                                                                           \
+    free(departs);                                                              \
+    free(comptes);                                                              \
+    free(tampon);                                                               \
+    return 0;                                                                   \
+}
+
+DEFINIR_TRI(u32, uint32_t)
+DEFINIR_TRI(u64, uint64_t)
+
+#endif
@@ -0,0 +1,261 @@
+/*
+ * VERROUS: Verrous à attente active (spinlocks)
+ *
+ * Bibliothèque "header-only". sum_with_critical (lab2) montre que
+ * "#pragma omp critical" est lent sans proposer d'alternative. Quatre
+ * verrous classiques:
+ *
+ * 1. TTAS + RECUL: test-and-test-and-set. On lit le verrou (en cache)
+ *    tant qu'il est pris, on ne tente l'échange atomique que s'il paraît
+ *    libre; après un échec, attente exponentielle (recul) pour éviter que
+ *    tous les threads se ruent en même temps. Pas équitable.
+ *
+ * 2. TICKET: comme au guichet. prendre = fetch_add sur "suivant" puis
+ *    attendre que "service" atteigne son ticket. Équitable (FIFO), mais
+ *    tous les threads lisent la même ligne "service".
+ *
+ * 3. MCS: file chaînée explicite; chaque thread attend sur SON nœud, le
+ *    précédent le réveille en écrivant dans ce nœud. FIFO, une seule
+ *    ligne modifiée par transfert.
+ *
+ *      queue ──> [T3] <── [T1].suivant = T3,  T1 tient le verrou
+ *
+ * 4. CLH: file implicite; chaque thread attend sur le nœud de son
+ *    PRÉDÉCESSEUR, puis recycle ce nœud pour le prochain passage.
+ *
+ * Toutes les attentes cèdent le cœur (sched_yield) après
+ * VERROU_ATTENTE_MAX tours: sur une machine surchargée, le détenteur
+ * du verrou peut être suspendu et les files FIFO se bloqueraient.
+ *
+ * Utilisation:
+ *
+ *   Verrou v;
+ *   verrou_init(&v, VERROU_MCS, nb_threads);
+ *   #pragma omp parallel num_threads(nb_threads)
+ *   {
+ *       int id = omp_get_thread_num();
+ *       verrou_prendre(&v, id);
+ *       ... section critique ...
+ *       verrou_rendre(&v, id);
+ *   }
+ *   verrou_liberer(&v);
+ */
+
+#ifndef VERROUS_H
+#define VERROUS_H
+
+#include <stdlib.h>
+#include <stdatomic.h>
+#include <sched.h>
+
+#define VERROU_LIGNE_CACHE 64
+#define VERROU_ATTENTE_MAX 1024
+#define VERROU_RECUL_MIN 4
+#define VERROU_RECUL_MAX 1024
+
+typedef enum {
+    VERROU_TTAS = 0,
+    VERROU_TICKET,
+    VERROU_MCS,
+    VERROU_CLH,
+    VERROU_NB_TYPES
+} TypeVerrou;
+
+static const char *const verrou_noms[VERROU_NB_TYPES] = {
+    "TTAS + recul", "ticket", "MCS", "CLH"
+};
+
+// Nœud de file (MCS et CLH), seul sur sa ligne de cache
+typedef struct VerrouNoeud {
+    _Alignas(VERROU_LIGNE_CACHE) _Atomic(struct VerrouNoeud*) suivant;   // MCS
+    atomic_int attend;      // MCS: 1 tant que le prédécesseur n'a pas rendu
+                            // CLH: 1 tant que le propriétaire tient le verrou
+} VerrouNoeud;
+
+// État privé d'un thread
+typedef struct {
+    _Alignas(VERROU_LIGNE_CACHE) VerrouNoeud *noeud;
+    VerrouNoeud *predecesseur;  // CLH: nœud récupéré au prochain rendre
+} VerrouLocal;
+
+typedef struct {
+    TypeVerrou type;
+    int nb_threads;
+
+    _Alignas(VERROU_LIGNE_CACHE) atomic_int pris;        // TTAS
+    _Alignas(VERROU_LIGNE_CACHE) atomic_long suivant;    // TICKET
+    _Alignas(VERROU_LIGNE_CACHE) atomic_long service;    // TICKET
+    _Alignas(VERROU_LIGNE_CACHE) _Atomic(VerrouNoeud*) queue;   // MCS, CLH
+
+    VerrouNoeud *noeuds;     // nb_threads + 1 (CLH: un nœud initial libre)
+    VerrouLocal *locaux;
+} Verrou;
+
+static inline void verrou_pause(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#endif
+}
+
+// Attente active puis sched_yield: retourne le nouveau compteur
+static inline int verrou_patienter(int attente) {
+    if (++attente >= VERROU_ATTENTE_MAX) {
+        sched_yield();
+        return 0;
+    }
+    verrou_pause();
+    return attente;
+}
+
+static inline void verrou_init(Verrou *v, TypeVerrou type, int nb_threads) {
+    v->type = type;
+    v->nb_threads = nb_threads;
+    atomic_init(&v->pris, 0);
+    atomic_init(&v->suivant, 0);
+    atomic_init(&v->service, 0);
+    v->noeuds = (VerrouNoeud*)aligned_alloc(VERROU_LIGNE_CACHE,
+                                            (nb_threads + 1) * sizeof(VerrouNoeud));
+    v->locaux = (VerrouLocal*)aligned_alloc(VERROU_LIGNE_CACHE,
+                                            nb_threads * sizeof(VerrouLocal));
+    for (int i = 0; i <= nb_threads; i++) {
+        atomic_init(&v->noeuds[i].suivant, NULL);
+        atomic_init(&v->noeuds[i].attend, 0);
+    }
+    for (int i = 0; i < nb_threads; i++) {
+        v->locaux[i].noeud = &v->noeuds[i];
+        v->locaux[i].predecesseur = NULL;
+    }
+    // MCS: file vide; CLH: file initialisée avec un nœud libre
+    atomic_init(&v->queue, (type == VERROU_CLH) ? &v->noeuds[nb_threads] : NULL);
+}
+
+static inline void verrou_liberer(Verrou *v) {
+    free(v->noeuds);
+    free(v->locaux);
+    v->noeuds = NULL;
+    v->locaux = NULL;
+}
+
+// ============================================================================
+// 1. TTAS + RECUL EXPONENTIEL
+// ============================================================================
+
+static inline void verrou_ttas_prendre(Verrou *v) {
+    int recul = VERROU_RECUL_MIN;
+    for (;;) {
+        int attente = 0;
+        while (atomic_load_explicit(&v->pris, memory_order_relaxed)) {
+            attente = verrou_patienter(attente);
+        }
+        if (!atomic_exchange_explicit(&v->pris, 1, memory_order_acquire)) return;
+        // Échec: un autre thread a gagné la course, on s'écarte
+        for (int k = 0; k < recul; k++) verrou_pause();
+        if (recul < VERROU_RECUL_MAX) recul *= 2;
+    }
+}
+
+static inline void verrou_ttas_rendre(Verrou *v) {
+    atomic_store_explicit(&v->pris, 0, memory_order_release);
+}
+
+// ============================================================================
+// 2. TICKET
+// ============================================================================
+
+static inline void verrou_ticket_prendre(Verrou *v) {
+    long ticket = atomic_fetch_add_explicit(&v->suivant, 1, memory_order_relaxed);
+    int attente = 0;
+    while (atomic_load_explicit(&v->service, memory_order_acquire) != ticket) {
+        attente = verrou_patienter(attente);
+    }
+}
+
+static inline void verrou_ticket_rendre(Verrou *v) {
+    // Seul le détenteur écrit "service"
+    long s = atomic_load_explicit(&v->service, memory_order_relaxed);
+    atomic_store_explicit(&v->service, s + 1, memory_order_release);
+}
+
+// ============================================================================
+// 3. MCS
+// ============================================================================
+
+static inline void verrou_mcs_prendre(Verrou *v, int id) {
+    VerrouNoeud *n = v->locaux[id].noeud;
+    atomic_store_explicit(&n->suivant, NULL, memory_order_relaxed);
+    atomic_store_explicit(&n->attend, 1, memory_order_relaxed);
+    VerrouNoeud *pred = atomic_exchange_explicit(&v->queue, n, memory_order_acq_rel);
+    if (pred == NULL) return;    // File vide: verrou obtenu
+    atomic_store_explicit(&pred->suivant, n, memory_order_release);
+    int attente = 0;
+    while (atomic_load_explicit(&n->attend, memory_order_acquire)) {
+        attente = verrou_patienter(attente);
+    }
+}
+
+static inline void verrou_mcs_rendre(Verrou *v, int id) {
+    VerrouNoeud *n = v->locaux[id].noeud;
+    VerrouNoeud *succ = atomic_load_explicit(&n->suivant, memory_order_acquire);
+    if (succ == NULL) {
+        // Personne en vue: on vide la file si on en est toujours le dernier
+        VerrouNoeud *attendu = n;
+        if (atomic_compare_exchange_strong_explicit(&v->queue, &attendu, NULL,
+                                                    memory_order_acq_rel,
+                                                    memory_order_relaxed)) {
+            return;
+        }
+        // Un successeur est en train de s'inscrire: attendre son lien
+        int attente = 0;
+        while ((succ = atomic_load_explicit(&n->suivant, memory_order_acquire)) == NULL) {
+            attente = verrou_patienter(attente);
+        }
+    }
+    atomic_store_explicit(&succ->attend, 0, memory_order_release);
+}
+
+// ============================================================================
+// 4. CLH
+// ============================================================================
+
+static inline void verrou_clh_prendre(Verrou *v, int id) {
+    VerrouLocal *l = &v->locaux[id];
+    atomic_store_explicit(&l->noeud->attend, 1, memory_order_relaxed);
+    VerrouNoeud *pred = atomic_exchange_explicit(&v->queue, l->noeud, memory_order_acq_rel);
+    int attente = 0;
+    while (atomic_load_explicit(&pred->attend, memory_order_acquire)) {
+        attente = verrou_patienter(attente);
+    }
+    l->predecesseur = pred;
+}
+
+static inline void verrou_clh_rendre(Verrou *v, int id) {
+    VerrouLocal *l = &v->locaux[id];
+    atomic_store_explicit(&l->noeud->attend, 0, memory_order_release);
+    // Notre nœud appartient maintenant au successeur; on prend celui du
+    // prédécesseur, que plus personne ne regarde
+    l->noeud = l->predecesseur;
+}
+
+// ============================================================================
+// INTERFACE COMMUNE
+// ============================================================================
+
+static inline void verrou_prendre(Verrou *v, int id) {
+    switch (v->type) {
+    case VERROU_TTAS:   verrou_ttas_prendre(v); break;
+    case VERROU_TICKET: verrou_ticket_prendre(v); break;
+    case VERROU_MCS:    verrou_mcs_prendre(v, id); break;
+    default:            verrou_clh_prendre(v, id); break;
+    }
+}
+
+static inline void verrou_rendre(Verrou *v, int id) {
+    switch (v->type) {
+    case VERROU_TTAS:   verrou_ttas_rendre(v); break;
+    case VERROU_TICKET: verrou_ticket_rendre(v); break;
+    case VERROU_MCS:    verrou_mcs_rendre(v, id); break;
+    default:            verrou_clh_rendre(v, id); break;
+    }
+}
+
+#endif
@@ -0,0 +1,371 @@
+/*
+ * VOL DE TRAVAIL: Runtime de tâches fork/join avec vol de travail
+ *
+ * Bibliothèque "header-only" (C11 + pthreads), alternative à #pragma omp task
+ *
+ * Principe:
+ * - Un worker (pthread) par cœur, chacun avec sa deque Chase-Lev sans verrou
+ * - Le propriétaire empile/dépile en bas (LIFO, bonne localité)
+ * - Les voleurs prennent en haut (FIFO, les plus grosses tâches)
+ * - Victime choisie au hasard quand la deque locale est vide
+ *
+ * API fork/join:
+ *
+ *   static void travail(void *arg) {
+ *       VtTache t;
+ *       vt_spawn(&t, sous_travail, &x);   // fork
+ *       sous_travail(&y);                 // le parent continue
+ *       vt_sync(&t);                      // join
+ *   }
+ *
+ *   VtRuntime *rt = vt_creer(0);          // 0 = un worker par cœur
+ *   vt_executer(rt, travail, &arg);       // bloque jusqu'à la fin
+ *   vt_detruire(rt);
+ *
+ * Compilation: gcc -fopenmp -O2 ... -pthread
+ * (définir _GNU_SOURCE avant le premier #include pour l'épinglage des workers)
+ */
+
+#ifndef VOL_TRAVAIL_H
+#define VOL_TRAVAIL_H
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+
+#define VT_TAILLE_INITIALE 256
+#define VT_LIGNE_CACHE 64
+
+typedef struct {
+    void (*fn)(void *);
+    void *arg;
+    atomic_int fini;
+} VtTache;
+
+// Tableau circulaire de la deque (taille puissance de 2)
+typedef struct VtTableau {
+    long taille;
+    struct VtTableau *precedent;   // Anciens tableaux: libérés à la destruction
+    _Atomic(VtTache*) elements[];
+} VtTableau;
+
+typedef struct {
+    atomic_long haut;              // Côté voleurs
+    char pad1[VT_LIGNE_CACHE - sizeof(atomic_long)];
+    atomic_long bas;               // Côté propriétaire
+    _Atomic(VtTableau*) tableau;
+    char pad2[VT_LIGNE_CACHE - sizeof(atomic_long) - sizeof(void*)];
+} VtDeque;
+
+struct VtRuntime;
+
+typedef struct {
+    VtDeque deque;
+    struct VtRuntime *rt;
+    pthread_t thread;
+    int id;
+    uint64_t graine;
+    // Statistiques (écrites par le worker seul)
+    long nb_spawns;
+    long nb_vols;
+    long nb_tentatives;
+} __attribute__((aligned(VT_LIGNE_CACHE))) VtWorker;
+
+typedef struct VtRuntime {
+    int nb_workers;
+    VtWorker *workers;
+    atomic_int arret;
+    atomic_int en_cours;           // Nombre de calculs racines actifs
+    _Atomic(VtTache*) injection;   // Tâche racine soumise de l'extérieur
+    pthread_mutex_t verrou;
+    pthread_cond_t reveil;
+} VtRuntime;
+
+static _Thread_local VtWorker *vt_worker_courant = NULL;
+
+// ============================================================================
+// DEQUE CHASE-LEV (version C11 de Lê, Pop, Cohen et Zappa Nardelli, 2013)
+// ============================================================================
+
+static inline VtTableau *vt_tableau_creer(long taille) {
+    VtTableau *a = (VtTableau*)malloc(sizeof(VtTableau) + taille * sizeof(VtTache*));
+    a->taille = taille;
+    a->precedent = NULL;
+    return a;
+}
+
+static inline void vt_deque_init(VtDeque *d) {
+    atomic_init(&d->haut, 0);
+    atomic_init(&d->bas, 0);
+    atomic_init(&d->tableau, vt_tableau_creer(VT_TAILLE_INITIALE));
+}
+
+static inline void vt_deque_liberer(VtDeque *d) {
+    VtTableau *a = atomic_load(&d->tableau);
+    while (a != NULL) {
+        VtTableau *p = a->precedent;
+        free(a);
+        a = p;
+    }
+}
+
+// Doublement du tableau (propriétaire seulement)
+static inline VtTableau *vt_deque_agrandir(VtDeque *d, VtTableau *a, long h, long b) {
+    VtTableau *nouveau = vt_tableau_creer(a->taille * 2);
+    for (long i = h; i < b; i++) {
+        atomic_store_explicit(&nouveau->elements[i & (nouveau->taille - 1)],
+            atomic_load_explicit(&a->elements[i & (a->taille - 1)], memory_order_relaxed),
+            memory_order_relaxed);
+    }
+    nouveau->precedent = a;   // Un voleur peut encore lire l'ancien tableau
+    atomic_store_explicit(&d->tableau, nouveau, memory_order_release);
+    return nouveau;
+}
+
+static inline void vt_deque_empiler(VtDeque *d, VtTache *t) {
+    long b = atomic_load_explicit(&d->bas, memory_order_relaxed);
+    long h = atomic_load_explicit(&d->haut, memory_order_acquire);
+    VtTableau *a = atomic_load_explicit(&d->tableau, memory_order_relaxed);
+    if (b - h > a->taille - 1) {
+        a = vt_deque_agrandir(d, a, h, b);
+    }
+    atomic_store_explicit(&a->elements[b & (a->taille - 1)], t, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&d->bas, b + 1, memory_order_relaxed);
+}
+
+static inline VtTache *vt_deque_depiler(VtDeque *d) {
+    long b = atomic_load_explicit(&d->bas, memory_order_relaxed) - 1;
+    VtTableau *a = atomic_load_explicit(&d->tableau, memory_order_relaxed);
+    atomic_store_explicit(&d->bas, b, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    long h = atomic_load_explicit(&d->haut, memory_order_relaxed);
+
+    VtTache *t = NULL;
+    if (h <= b) {
+        t = atomic_load_explicit(&a->elements[b & (a->taille - 1)], memory_order_relaxed);
+        if (h == b) {
+            // Dernier élément: course possible avec un voleur
+            if (!atomic_compare_exchange_strong_explicit(&d->haut, &h, h + 1,
+                    memory_order_seq_cst, memory_order_relaxed)) {
+                t = NULL;
+            }
+            atomic_store_explicit(&d->bas, b + 1, memory_order_relaxed);
+        }
+    } else {
+        atomic_store_explicit(&d->bas, b + 1, memory_order_relaxed);
+    }
+    return t;
+}
+
+static inline VtTache *vt_deque_voler(VtDeque *d) {
+    long h = atomic_load_explicit(&d->haut, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    long b = atomic_load_explicit(&d->bas, memory_order_acquire);
+
+    if (h < b) {
+        VtTableau *a = atomic_load_explicit(&d->tableau, memory_order_acquire);
+        VtTache *t = atomic_load_explicit(&a->elements[h & (a->taille - 1)],
+                                          memory_order_relaxed);
+        if (!atomic_compare_exchange_strong_explicit(&d->haut, &h, h + 1,
+                memory_order_seq_cst, memory_order_relaxed)) {
+            return NULL;  // Perdu la course
+        }
+        return t;
+    }
+    return NULL;
+}
+
+// ============================================================================
+// WORKERS
+// ============================================================================
+
+static inline uint64_t vt_aleatoire(VtWorker *w) {
+    // xorshift64
+    w->graine ^= w->graine << 13;
+    w->graine ^= w->graine >> 7;
+    w->graine ^= w->graine << 17;
+    return w->graine;
+}
+
+static inline void vt_executer_tache(VtTache *t) {
+    t->fn(t->arg);
+    atomic_store_explicit(&t->fini, 1, memory_order_release);
+}
+
+// Une tentative de vol chez une victime aléatoire
+static inline VtTache *vt_voler_aleatoire(VtWorker *w) {
+    VtRuntime *rt = w->rt;
+    if (rt->nb_workers < 2) return NULL;
+    int victime = (int)(vt_aleatoire(w) % (uint64_t)(rt->nb_workers - 1));
+    if (victime >= w->id) victime++;
+    w->nb_tentatives++;
+    VtTache *t = vt_deque_voler(&rt->workers[victime].deque);
+    if (t != NULL) w->nb_vols++;
+    return t;
+}
+
+static inline VtTache *vt_trouver_travail(VtWorker *w) {
+    VtTache *t = vt_deque_depiler(&w->deque);
+    if (t != NULL) return t;
+    if (atomic_load_explicit(&w->rt->injection, memory_order_relaxed) != NULL) {
+        t = atomic_exchange(&w->rt->injection, NULL);
+        if (t != NULL) return t;
+    }
+    return vt_voler_aleatoire(w);
+}
+
+static inline void *vt_boucle_worker(void *arg) {
+    VtWorker *w = (VtWorker*)arg;
+    VtRuntime *rt = w->rt;
+    vt_worker_courant = w;
+
+    // Un worker par cœur: épinglage sur le cœur id
+    long nb_coeurs = sysconf(_SC_NPROCESSORS_ONLN);
+    if (nb_coeurs > 0) {
+        cpu_set_t ensemble;
+        CPU_ZERO(&ensemble);
+        CPU_SET(w->id % nb_coeurs, &ensemble);
+        pthread_setaffinity_np(pthread_self(), sizeof(ensemble), &ensemble);
+    }
+
+    int echecs = 0;
+    while (!atomic_load_explicit(&rt->arret, memory_order_relaxed)) {
+        VtTache *t = vt_trouver_travail(w);
+        if (t != NULL) {
+            vt_executer_tache(t);
+            echecs = 0;
+            continue;
+        }
+        // Rien à faire: attente active courte, puis sommeil si aucun calcul
+        if (++echecs < 64) continue;
+        sched_yield();
+        if (atomic_load(&rt->en_cours) == 0) {
+            pthread_mutex_lock(&rt->verrou);
+            while (atomic_load(&rt->en_cours) == 0 && !atomic_load(&rt->arret)) {
+                pthread_cond_wait(&rt->reveil, &rt->verrou);
+            }
+            pthread_mutex_unlock(&rt->verrou);
+            echecs = 0;
+        }
+    }
+    return NULL;
+}
+
+// ============================================================================
+// API PUBLIQUE
+// ============================================================================
+
+static inline VtRuntime *vt_creer(int nb_workers) {
+    if (nb_workers <= 0) {
+        long n = sysconf(_SC_NPROCESSORS_ONLN);
+        nb_workers = (n > 0) ? (int)n : 1;
+    }
+    VtRuntime *rt = (VtRuntime*)calloc(1, sizeof(VtRuntime));
+    rt->nb_workers = nb_workers;
+    rt->workers = (VtWorker*)aligned_alloc(VT_LIGNE_CACHE, nb_workers * sizeof(VtWorker));
+    atomic_init(&rt->arret, 0);
+    atomic_init(&rt->en_cours, 0);
+    atomic_init(&rt->injection, NULL);
+    pthread_mutex_init(&rt->verrou, NULL);
+    pthread_cond_init(&rt->reveil, NULL);
+
+    for (int i = 0; i < nb_workers; i++) {
+        VtWorker *w = &rt->workers[i];
+        vt_deque_init(&w->deque);
+        w->rt = rt;
+        w->id = i;
+        w->graine = 0x9E3779B97F4A7C15ull * (uint64_t)(i + 1);
+        w->nb_spawns = w->nb_vols = w->nb_tentatives = 0;
+    }
+    for (int i = 0; i < nb_workers; i++) {
+        pthread_create(&rt->workers[i].thread, NULL, vt_boucle_worker, &rt->workers[i]);
+    }
+    return rt;
+}
+
+static inline void vt_detruire(VtRuntime *rt) {
+    pthread_mutex_lock(&rt->verrou);
+    atomic_store(&rt->arret, 1);
+    pthread_cond_broadcast(&rt->reveil);
+    pthread_mutex_unlock(&rt->verrou);
+    for (int i = 0; i < rt->nb_workers; i++) {
+        pthread_join(rt->workers[i].thread, NULL);
+        vt_deque_liberer(&rt->workers[i].deque);
+    }
+    pthread_mutex_destroy(&rt->verrou);
+    pthread_cond_destroy(&rt->reveil);
+    free(rt->workers);
+    free(rt);
+}
+
+// Fork: rend la tâche visible aux voleurs (appel depuis un worker uniquement)
+static inline void vt_spawn(VtTache *t, void (*fn)(void *), void *arg) {
+    VtWorker *w = vt_worker_courant;
+    t->fn = fn;
+    t->arg = arg;
+    atomic_store_explicit(&t->fini, 0, memory_order_relaxed);
+    w->nb_spawns++;
+    vt_deque_empiler(&w->deque, t);
+}
+
+// Join: exécute du travail (local puis volé) jusqu'à la fin de t
+static inline void vt_sync(VtTache *t) {
+    VtWorker *w = vt_worker_courant;
+    while (!atomic_load_explicit(&t->fini, memory_order_acquire)) {
+        VtTache *x = vt_deque_depiler(&w->deque);
+        if (x == NULL) x = vt_voler_aleatoire(w);
+        if (x != NULL) {
+            vt_executer_tache(x);
+        }
+    }
+}
+
+// Exécute fn(arg) sur le runtime depuis un thread externe et attend la fin
+static inline void vt_executer(VtRuntime *rt, void (*fn)(void *), void *arg) {
+    VtTache racine;
+    racine.fn = fn;
+    racine.arg = arg;
+    atomic_init(&racine.fini, 0);
+
+    pthread_mutex_lock(&rt->verrou);
+    atomic_fetch_add(&rt->en_cours, 1);
+    pthread_cond_broadcast(&rt->reveil);
+    pthread_mutex_unlock(&rt->verrou);
+
+    VtTache *attendu = NULL;
+    while (!atomic_compare_exchange_weak(&rt->injection, &attendu, &racine)) {
+        attendu = NULL;
+        sched_yield();
+    }
+    while (!atomic_load_explicit(&racine.fini, memory_order_acquire)) {
+        sched_yield();
+    }
+    atomic_fetch_sub(&rt->en_cours, 1);
+}
+
+// Statistiques cumulées de tous les workers
+static inline void vt_statistiques(VtRuntime *rt, long *spawns, long *vols, long *tentatives) {
+    *spawns = *vols = *tentatives = 0;
+    for (int i = 0; i < rt->nb_workers; i++) {
+        *spawns += rt->workers[i].nb_spawns;
+        *vols += rt->workers[i].nb_vols;
+        *tentatives += rt->workers[i].nb_tentatives;
+    }
+}
+
+static inline void vt_reinitialiser_statistiques(VtRuntime *rt) {
+    for (int i = 0; i < rt->nb_workers; i++) {
+        rt->workers[i].nb_spawns = 0;
+        rt->workers[i].nb_vols = 0;
+        rt->workers[i].nb_tentatives = 0;
+    }
+}
+
+#endif
@@ -3,57 +3,109 @@
 #include <stdlib.h>
 #include <unistd.h>
 #include <time.h>
+#include "Labs/journal.h"
+#include "Labs/progression.h"
+#include "Labs/partition.h"
 
 void exemple_initialisation() {
     printf("=== EXEMPLE 1: INITIALISATION ===\n");
     
     int *donnees = NULL;
-    int taille = 1000;
+    size_t taille = 1 << 20;     // 4 Mo: plusieurs pages par thread
+    long somme = 0;
     
-    #pragma omp parallel num_threads(4)
+    #pragma omp parallel num_threads(4) reduction(+:somme)
     {
         int thread_id = omp_get_thread_num();
         
+        // Un seul thread alloue (single), tous reçoivent le pointeur.
+        // Aucune page n'est encore touchée.
+        int *d = (int*)partition_allouer(taille * sizeof(int));
+        
         #pragma omp master
         {
-            printf("Thread master (%d): J'alloue la mémoire pour tous\n", thread_id);
-            donnees = malloc(taille * sizeof(int));
-            
-            // Initialisation que seul le master doit faire
-            printf("Thread master (%d): J'initialise les données\n", thread_id);
-            for (int i = 0; i < taille; i++) {
-                donnees[i] = i * 2;
-            }
+            printf("Thread master (%d): J'ai alloué la mémoire pour tous\n", thread_id);
+            donnees = d;
         }
         
-        // BARRIERE IMPLICITE : tous les threads attendent que le master finisse
-        
-        // Maintenant tous les threads peuvent utiliser 'donnees'
-        printf("Thread %d: Je peux maintenant utiliser les données\n", thread_id);
-        
-        // Chaque thread traite sa partie
-        int chunk = taille / 4;
-        int debut = thread_id * chunk;
-        int fin = (thread_id == 3) ? taille : debut + chunk;
+        // Chaque thread initialise SA tranche: premier contact, les pages
+        // sont placées près du thread qui va les utiliser (NUMA)
+        size_t debut, fin;
+        partition_tranche(taille, sizeof(int), &debut, &fin);
+        if (d != NULL) {
+            for (size_t i = debut; i < fin; i++) {
+                d[i] = (int)i * 2;
+            }
+        }
+        printf("Thread %d: J'initialise et je traite [%zu, %zu)\n", thread_id, debut, fin);
         
-        int somme_locale = 0;
-        for (int i = debut; i < fin; i++) {
-            somme_locale += donnees[i];
+        // Même tranche pour le calcul: pas besoin d'attendre les autres
+        long somme_locale = 0;
+        if (d != NULL) {
+            for (size_t i = debut; i < fin; i++) {
+                somme_locale += d[i];
+            }
         }
-        printf("Thread %d: ma somme locale = %d\n", thread_id, somme_locale);
+        printf("Thread %d: ma somme locale = %ld\n", thread_id, somme_locale);
+        somme += somme_locale;
     }
     
+    printf("Somme totale (reduction): %ld\n", somme);
     free(donnees);
     printf("\n");
 }
 
-
-
+void exemple_affichage_progression() {
+    printf("=== EXEMPLE 1b: AFFICHAGE DE LA PROGRESSION ===\n");
+    
+    // Le master ne peut pas afficher pendant le "omp for" (il calcule
+    // aussi): les threads comptent leurs itérations dans des cases
+    // séparées et un thread moniteur affiche le débit et le temps restant
+    int nb_etapes = 200;
+    Progression progression;
+    int suivi = 0;
+    long total = 0;
+    
+    #pragma omp parallel num_threads(4) reduction(+:total)
+    {
+        int thread_id = omp_get_thread_num();
+        
+        #pragma omp master
+        {
+            printf("Thread master (%d): Je lance le moniteur de progression\n", thread_id);
+            suivi = (progression_demarrer(&progression, "calcul", nb_etapes,
+                                          omp_get_num_threads(), 0.1) == 0);
+        }
+        
+        // master n'a pas de barrière implicite: attendre le moniteur
+        #pragma omp barrier
+        
+        #pragma omp for schedule(dynamic)
+        for (int etape = 0; etape < nb_etapes; etape++) {
+            usleep(5000);     // Simulation d'une étape de calcul
+            total += etape;
+            if (suivi) progression_avancer(&progression, thread_id, 1);
+        }
+        
+        // BARRIERE IMPLICITE de "omp for": toutes les étapes sont faites
+        #pragma omp master
+        {
+            if (suivi) {
+                double duree = progression_terminer(&progression);
+                printf("Thread master (%d): %d étapes en %.2f s\n", thread_id, nb_etapes, duree);
+            }
+        }
+    }
+    printf("Somme des étapes: %ld\n\n", total);
+}
 
 void exemple_fichier_log() {
     printf("=== EXEMPLE 2: ECRITURE DANS UN FICHIER LOG ===\n");
     
-    FILE *fichier = NULL;
+    // Journal binaire: chaque thread écrit dans son anneau sans verrou,
+    // un thread écrivain fait les write(), le texte est produit à la fin
+    Journal journal;
+    int journal_ouvert = 0;
     
     #pragma omp parallel num_threads(4)
     {
@@ -61,35 +113,55 @@ void exemple_fichier_log() {
         
         #pragma omp master
         {
-            printf("Thread master (%d): J'ouvre le fichier de log\n", thread_id);
-            fichier = fopen("calcul.log", "w");
-            if (fichier) {
-                fprintf(fichier, "=== DEBUT DU CALCUL PARALLELE ===\n");
-                fprintf(fichier, "Nombre de threads: %d\n", omp_get_num_threads());
-                fprintf(fichier, "Timestamp: %d\n", (int)time(NULL));
-                fflush(fichier);
+            printf("Thread master (%d): J'ouvre le journal\n", thread_id);
+            journal_ouvert = (journal_ouvrir(&journal, "calcul.journal",
+                                             omp_get_num_threads(), 4096) == 0);
+            if (journal_ouvert) {
+                JOURNAL(&journal, thread_id, "=== DEBUT DU CALCUL PARALLELE ===");
+                JOURNAL(&journal, thread_id, "Nombre de threads: %d", omp_get_num_threads());
+                JOURNAL(&journal, thread_id, "Timestamp: %ld", (long)time(NULL));
             }
         }
         
+        // master n'a pas de barrière implicite: attendre l'ouverture
+        #pragma omp barrier
+        
         // Tous les threads font leur travail
         printf("Thread %d: Je fais mon calcul...\n", thread_id);
         
-        // Simulation de calcul
+        // Simulation de calcul, journalisée depuis la boucle
         int resultat = 0;
         for (int i = 0; i < 100000; i++) {
             resultat += i * thread_id;
+            if (journal_ouvert && i % 25000 == 0) {
+                JOURNAL(&journal, thread_id, "Thread %d: i = %d, résultat partiel = %d",
+                        thread_id, i, resultat);
+            }
         }
         
         printf("Thread %d: Mon résultat = %d\n", thread_id, resultat);
+        if (journal_ouvert) {
+            JOURNAL(&journal, thread_id, "Thread %d: Mon résultat = %d", thread_id, resultat);
+        }
+        
+        // Tous les messages doivent être écrits avant la fermeture
+        #pragma omp barrier
         
         // Seul le master écrit la conclusion
         #pragma omp master
         {
-            if (fichier) {
+            if (journal_ouvert) {
                 printf("Thread master (%d): J'écris la conclusion dans le log\n", thread_id);
-                fprintf(fichier, "=== FIN DU CALCUL ===\n");
-                fprintf(fichier, "Tous les threads ont terminé\n");
-                fclose(fichier);
+                JOURNAL(&journal, thread_id, "=== FIN DU CALCUL ===");
+                JOURNAL(&journal, thread_id, "Tous les threads ont terminé");
+                journal_fermer(&journal);
+                
+                // Post-traitement: formatage hors de la région parallèle
+                FILE *fichier = fopen("calcul.log", "w");
+                if (fichier) {
+                    journal_decoder("calcul.journal", fichier);
+                    fclose(fichier);
+                }
             }
         }
     }